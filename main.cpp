@@ -1,26 +1,14 @@
+#include <iomanip>
 #include <iostream>
+#include <random>
 #include <string>
-#include <array>
-#include <vector>
-#include <random> // for std::random_device and std::mt19937
+#include <limits>
 
-typedef std::array<int, 4> DigitCombination;
-typedef std::vector<DigitCombination> CombinationList;
-
-struct Score
-{
-    int right_position;
-    int wrong_position;
-
-    Score() : right_position(0), wrong_position(0) {}
-
-    // Overloading the equality operator
-    bool operator==(const Score &other) const
-    {
-        return right_position == other.right_position
-               && wrong_position == other.wrong_position;
-    }
-};
+#include "digitmind.h"
+#include "game_analysis.h"
+#include "level_cache.h"
+#include "secret_difficulty.h"
+#include "strategy.h"
 
 enum GameMode
 {
@@ -29,58 +17,6 @@ enum GameMode
     PlayerGuesses
 };
 
-/**
- * @brief Calculate the score for a guess against a secret code.
- *
- * @param guess The guessed digit combination.
- * @param code The secret digit combination.
- * @return Score The resulting score of the guess.
- *
- * The score is calculated based on the number of digits in the correct
- * position (right position) and the number of digits that are in the code
- * but in the wrong position (wrong position).
- *
- * The function iterates through each digit of the guess and checks if it
- * is in the correct position or the wrong position.
- *
- * If a digit is in the correct position, the `right_position` score is
- * incremented. If a digit is in the code but not in the correct position,
- * the `wrong_position` score is incremented and the digit is marked as counted.
- *
- * @note The function assumes that both `guess` and `code` are valid digit
- * combinations of length 4.
- *
- * @see Score
- * @see DigitCombination
- */
-Score calculateScore(DigitCombination guess, DigitCombination code)
-{
-    Score score;
-
-    for (int i = 0; i < 4; i++)
-    {
-        if (guess[i] == code[i])
-        {
-            // Correct digit at right position
-            score.right_position++;
-        }
-        else
-        {
-            // Check if guess digit is in code
-            for (int j = 0; j < 4; j++)
-            {
-                if (guess[i] == code[j])
-                {
-                    score.wrong_position++;
-                    break;
-                }
-            }
-        }
-    }
-
-    return score;
-}
-
 /**
  * @brief Gets the difficulty level from the user.
  *
@@ -97,7 +33,7 @@ int getDifficultyLevel()
     std::cin >> level;
 
     // Check if the input value is in the correct range.
-    while(std::cin.fail() || level < 4 || level > 10)
+    while(std::cin.fail() || level < MIN_LEVEL || level > MAX_LEVEL)
     {
         std::cin.clear();    // reset the error flags
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');    // ignore rest of the line
@@ -108,100 +44,55 @@ int getDifficultyLevel()
 }
 
 /**
- * @brief Generates all possible combinations of digits from 0 to level-1.
+ * @brief Gets the strategy of the computer from the user.
  *
- * This function generates all possible combinations of digits from 0 to level-1
- * without repetition. Each combination is represented by a DigitCombination,
- * which is an array of 4 integers.
+ * This function prompts the user to choose how the computer selects its
+ * guesses. If the user enters an invalid value, they are prompted to enter a
+ * valid value until it is received.
  *
- * @param level The maximum digit value (level-1) for generating combinations.
- * @return CombinationList A vector of DigitCombinations representing all the
- * combinations.
+ * @return The strategy selected by the user.
  */
-CombinationList generateAllCombinations(int level)
+Strategy getStrategy()
 {
-    CombinationList allCombinations;
-    DigitCombination combination;
-
-    // Generate combinations from '0123' to 'level-1 level-1 level-1 level-1'
-    for (int i = 0; i < level; i++)
+    int choice = 0;
+    std::cout << "Choose the computer's strategy:\n"
+              << "0. Random possible combination\n"
+              << "1. Minimax (smallest worst case)\n"
+              << "2. Entropy (most information)\n"
+              << "3. Lookahead (fewest combinations after two guesses)\n"
+              << "4. Bayesian (most information, expecting a secret chosen like people do)\n"
+              << "\n"
+              << "Enter the number of your chosen strategy: ";
+    std::cin >> choice;
+
+    while (std::cin.fail() || choice < 0 || choice > 4)
     {
-        for (int j = 0; j < level; j++)
-        {
-            for (int k = 0; k < level; k++)
-            {
-                for (int l = 0; l < level; l++)
-                {
-                    if (i != j && i != k && i != l && j != k && j != l && k != l)
-                    {
-                        allCombinations.push_back(DigitCombination{i, j, k, l});
-                    }
-                }
-            }
-        }
-    }
-    return allCombinations;
-}
-
-/**
- * @brief Filter combinations based on guess and score.
- *
- * This function filters a list of combinations based on a guess and score.
- * It removes combinations that don't produce the same score as the
- * guess and score provided.
- *
- * @param allCombinations The list of combinations to filter.
- * @param guess The guess combination.
- * @param score The score to compare against.
- */
-void filterCombinations(CombinationList& allCombinations,
-                        const DigitCombination& guess,
-                        const Score& score)
-{
-    // Iterate over list of combinations and remove those that
-    // don't produce the same score
-    auto it = allCombinations.begin();
-    while (it != allCombinations.end())
-    {
-        if (calculateScore(guess, *it) == score)
-        {
-            ++it;
-            continue;
-        }
-
-        it = allCombinations.erase(it);  // erase returns the new iterator
+        std::cin.clear();    // reset the error flags
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');    // ignore rest of the line
+        std::cout << "Invalid choice. Please enter a number between 0 and 4: ";
+        std::cin >> choice;
     }
-}
-
-/**
- * @brief Selects a random combination from a list of combinations.
- *
- * @param combinations The list of combinations to select from.
- * @return The randomly selected combination.
- */
-DigitCombination selectRandomCombination(const CombinationList& combinations)
-{
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<CombinationList::size_type> dis(0, combinations.size() - 1);
-    return combinations[dis(gen)];
+    return static_cast<Strategy>(choice);
 }
 
 /**
  * @brief Performs the computer's move in the game.
  *
- * This function selects a random combination from the provided list of combinations,
+ * This function selects a combination using the chosen strategy,
  * displays it to the user, and then gets the user's feedback in terms of the number of digits
  * in the correct position and the number of correct digits in the wrong position.
  * The score is then used to filter the list of combinations, removing those combinations that do not
  * produce the same score as the guessed combination.
  *
- * @param combinations The list of combinations to choose from.
+ * @param level The difficulty level of the game.
+ * @param strategy The strategy used to select the guess.
+ * @param game The state of the game: the combinations to choose from, the
+ * partition histograms kept up to date with them and the moves made so far.
  * @return Whether the code was guessed
  */
-bool performComputerMove(CombinationList& combinations)
+bool performComputerMove(const int level, Strategy strategy, GameState& game)
 {
-    DigitCombination guess = selectRandomCombination(combinations);
+    DigitCombination guess = selectGuess(strategy, level, game.history, game.candidates, &game.histograms);
 
     // Show guess to user
     std::cout << "Computer's guess: ";
@@ -225,7 +116,8 @@ bool performComputerMove(CombinationList& combinations)
     std::cin >> score.wrong_position;
 
     // Use score to filter combinations
-    filterCombinations(combinations, guess, score);
+    game.histograms.filter(game.candidates, guess, score);
+    game.history.push_back(Move{guess, score});
 
     return false;
 }
@@ -233,25 +125,27 @@ bool performComputerMove(CombinationList& combinations)
 /**
  * @brief Executes the computer player's turn in the game.
  *
- * This function performs the computer player's move in the game by selecting a random combination
- * from the provided list of combinations. It then displays the selected combination to the user
+ * This function performs the computer player's move in the game by selecting a combination
+ * from the provided list of combinations using the chosen strategy. It then displays the selected combination to the user
  * and waits for the user's feedback in terms of the number of digits in the correct position
  * and the number of correct digits in the wrong position. The obtained score is used to filter
  * the list of combinations by removing those combinations that do not produce the same score as
  * the guessed combination. The process continues until the code is guessed correctly.
  *
- * @param combinations The list of combinations to choose from.
+ * @param level The difficulty level of the game.
+ * @param strategy The strategy used to select the guesses.
+ * @param game The state of the game, starting with all combinations.
  */
-void computerPlayer(CombinationList& combinations)
+void computerPlayer(const int level, Strategy strategy, GameState& game)
 {
     bool codeGuessed;
     do
     {
         // Perform a computer move and get the score
-        codeGuessed = performComputerMove(combinations);
+        codeGuessed = performComputerMove(level, strategy, game);
 
         // Check if combinations list is empty due to incorrect user input
-        if (combinations.empty() && !codeGuessed)
+        if (game.candidates.empty() && !codeGuessed)
         {
             std::cout << "Input error detected, restarting game...\n";
             return;
@@ -261,22 +155,126 @@ void computerPlayer(CombinationList& combinations)
     std::cout << "The computer has guessed your combination!\n";
 }
 
+/**
+ * @brief Shows how good the moves of a game were.
+ *
+ * For every move the number of combinations left, the information the score
+ * gave, the information the guess was expected to give and the best guess with
+ * its expected information are shown.
+ *
+ * @param level The difficulty level of the game.
+ * @param history The moves of the game.
+ */
+void showAnalysis(const int level, const GameHistory& history)
+{
+    auto toString = [](const DigitCombination& combination)
+    {
+        std::string text;
+        for (int digit : combination)
+        {
+            text += static_cast<char>('0' + digit);
+        }
+        return text;
+    };
+
+    std::cout << "\nMove  Guess  Score  Left  Bits gained  Bits expected  Best guess  Bits expected  Regret\n"
+              << std::fixed << std::setprecision(2);
+    int number = 1;
+    for (const MoveAnalysis& analysis : analyzeGame(level, history))
+    {
+        std::cout << std::setw(4) << number++ << std::setw(7) << toString(analysis.move.guess)
+                  << std::setw(5) << analysis.move.score.right_position << "," << analysis.move.score.wrong_position
+                  << std::setw(6) << analysis.candidatesAfter << std::setw(13) << analysis.informationGained
+                  << std::setw(15) << analysis.player.entropy << std::setw(12) << toString(analysis.best.guess)
+                  << std::setw(15) << analysis.best.entropy << std::setw(8) << analysis.regret << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
+
+/**
+ * @brief Selects the secret combination for a human player.
+ *
+ * When the difficulty table of the entropy strategy is available for the
+ * level, the player chooses how hard the secret should be for that strategy,
+ * and the secret is drawn from that tier. Otherwise every combination is
+ * equally likely.
+ *
+ * @param level The difficulty level of the game.
+ * @param combinations All combinations of the level.
+ * @return The secret combination.
+ */
+DigitCombination selectSecret(const int level, const CombinationList& combinations)
+{
+    const SecretSelector* selector = secretSelector(Strategy::Entropy, level);
+    if (selector == nullptr)
+    {
+        return selectRandomCombination(combinations);
+    }
+
+    int choice = 0;
+    std::cout << "Choose the difficulty of the secret combination:\n"
+              << "0. Any\n"
+              << "1. Easy\n"
+              << "2. Medium\n"
+              << "3. Hard\n"
+              << "\n"
+              << "Enter the number of your chosen difficulty: ";
+    std::cin >> choice;
+
+    while (std::cin.fail() || choice < 0 || choice > 3)
+    {
+        std::cin.clear();    // reset the error flags
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');    // ignore rest of the line
+        std::cout << "Invalid choice. Please enter a number between 0 and 3: ";
+        std::cin >> choice;
+    }
+
+    static std::mt19937 gen(std::random_device{}());
+    return selector->select(static_cast<SecretTier>(choice), gen);
+}
+
+/**
+ * @brief Converts the text entered by the player into a guess.
+ *
+ * @param input The text entered by the player.
+ * @param level The difficulty level.
+ * @param guess Receives the guess when the text is valid.
+ * @return True if the text is exactly 4 distinct digits between 0 and level-1.
+ */
+bool parseGuess(const std::string& input, int level, DigitCombination& guess)
+{
+    if (input.size() != 4)
+    {
+        return false;
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        if (input[i] < '0' || input[i] > '9')
+        {
+            return false;
+        }
+        guess[i] = input[i] - '0';  // Using ASCII code to convert characters to integers
+    }
+    return isValidCombination(guess, level);
+}
+
 /**
  * @brief Allows a human player to guess a secret combination.
  *
  * This function prompts the player to enter a guess and provides feedback
  * based on the correctness of the guess. The function continues until the
- * player guesses the correct combination.
+ * player guesses the correct combination. The moves are recorded in the game
+ * state and analyzed at the end.
  *
  * @param level The maximum digit value for the combination (0 to level-1).
- * @param combinations The list of combinations to select from.
+ * @param game The state of the game, starting with all combinations.
  *
  * @see CombinationList
  */
-void humanPlayer(const int level, CombinationList& combinations)
+void humanPlayer(const int level, GameState& game)
 {
     // Computer selects a secret combination
-    auto secretCode = selectRandomCombination(combinations);
+    auto secretCode = selectSecret(level, game.candidates);
 
     Score score;
     do
@@ -287,14 +285,20 @@ void humanPlayer(const int level, CombinationList& combinations)
         std::string input;
         std::cin >> input;
 
-        // Convert string characters to integers and store them in playerGuess
-        for(int i = 0; i < 4; ++i)
+        // Re-prompt until the guess is 4 distinct digits of the level
+        while (!parseGuess(input, level, playerGuess))
         {
-            playerGuess[i] = input[i] - '0';  // Using ASCII code to convert characters to integers
+            if (!std::cin)
+            {
+                return;    // the input ended before the combination was found
+            }
+            std::cout << "Invalid guess. Please enter 4 distinct digits between 0 and " << level - 1 << ": ";
+            std::cin >> input;
         }
 
         // Calculate the score based on the player's guess and the secret combination
         score = calculateScore(playerGuess, secretCode);
+        game.history.push_back(Move{playerGuess, score});
 
         // Provide feedback to the player
         std::cout << "Digits in the right position: " << score.right_position << "\n";
@@ -303,6 +307,7 @@ void humanPlayer(const int level, CombinationList& combinations)
 
     // The secret code has been found
     std::cout << "Congratulations, you have guessed the combination!\n";
+    showAnalysis(level, game.history);
 }
 
 /**
@@ -355,6 +360,9 @@ int main()
 {
     std::cout << "-- Welcome to DigitMind --\n";
 
+    // Build the tables of all levels while the user reads the menu
+    prewarmLevelData();
+
     while (true)
     {
         auto choice = menu();
@@ -364,17 +372,18 @@ int main()
             exit(0);
         }
 
-        // Get difficulty level and generate all possible combinations
+        // Get difficulty level and start from all possible combinations
         auto level = getDifficultyLevel();
-        auto combinations = generateAllCombinations(level);
+        GameState game(levelData(level));
 
         if ( choice == GameMode::ComputerGuesses)
         {
-            computerPlayer(combinations);
+            auto strategy = getStrategy();
+            computerPlayer(level, strategy, game);
         }
         else if (choice == GameMode::PlayerGuesses)
         {
-            humanPlayer(level, combinations);
+            humanPlayer(level, game);
         }
     }
 }
\ No newline at end of file
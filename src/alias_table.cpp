@@ -0,0 +1,43 @@
+#include "alias_table.h"
+
+#include <numeric>
+
+AliasTable::AliasTable(const std::vector<double>& weights)
+    : probabilities(weights.size()), aliases(weights.size())
+{
+    double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::size_t i = 0; i < weights.size(); i++)
+    {
+        probabilities[i] = weights[i] * weights.size() / total;
+        aliases[i] = static_cast<std::uint32_t>(i);
+        (probabilities[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+
+    // Top up every short column from a tall one, which may become short itself
+    while (!small.empty() && !large.empty())
+    {
+        std::uint32_t shortColumn = small.back();
+        small.pop_back();
+        std::uint32_t tallColumn = large.back();
+
+        aliases[shortColumn] = tallColumn;
+        probabilities[tallColumn] -= 1.0 - probabilities[shortColumn];
+        if (probabilities[tallColumn] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(tallColumn);
+        }
+    }
+
+    // What is left is 1 up to rounding errors
+    for (std::uint32_t column : large)
+    {
+        probabilities[column] = 1.0;
+    }
+    for (std::uint32_t column : small)
+    {
+        probabilities[column] = 1.0;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Draws indices with given weights in constant time (Vose's alias method).
+ *
+ * The weights are scaled so that they average 1, and every index gets a
+ * column of height 1: its own probability up to its scaled weight, topped up
+ * with an alias, an index whose weight exceeds 1. Drawing picks a column
+ * uniformly and then either the index or its alias with one comparison,
+ * whatever the number and distribution of the weights.
+ */
+class AliasTable
+{
+public:
+    /**
+     * @param weights The non-negative weight of every index; at least one is
+     * positive.
+     */
+    explicit AliasTable(const std::vector<double>& weights);
+
+    /**
+     * @brief Draws an index with probability proportional to its weight.
+     */
+    std::size_t sample(std::mt19937& gen) const
+    {
+        std::size_t column = std::uniform_int_distribution<std::size_t>(0, probabilities.size() - 1)(gen);
+        return std::uniform_real_distribution<double>(0.0, 1.0)(gen) < probabilities[column] ? column
+                                                                                              : aliases[column];
+    }
+
+    /**
+     * @brief Returns the number of indices.
+     */
+    std::size_t size() const
+    {
+        return probabilities.size();
+    }
+
+private:
+    std::vector<double> probabilities;      // Probability of a column's own index
+    std::vector<std::uint32_t> aliases;     // Index drawn otherwise
+};
@@ -0,0 +1,57 @@
+#include "bayesian.h"
+
+#include <cmath>
+
+#include "level_cache.h"
+#include "weighted_candidates.h"
+
+namespace
+{
+
+/**
+ * @brief Returns whether guess `a`, winning with weight `winA`, is better than `b`.
+ */
+bool isBetterBayesian(const GuessEvaluation& a, double winA, const GuessEvaluation& b, double winB)
+{
+    // Entropies and weights of equally good guesses differ only by rounding
+    const double epsilon = 1e-9;
+    if (std::abs(a.entropy - b.entropy) > epsilon)
+    {
+        return a.entropy > b.entropy;
+    }
+    if (std::abs(winA - winB) > epsilon * (winA + winB))
+    {
+        return winA > winB;
+    }
+    return a.expectedSize < b.expectedSize - epsilon;
+}
+
+} // namespace
+
+GuessEvaluation searchBayesian(int level, const CombinationList& candidates, const SecretPrior& prior,
+                               const BayesianOptions& options)
+{
+    WeightedCandidates weighted(candidates, prior);
+    double posterior = weighted.highestWeight() / weighted.totalWeight();
+    if (candidates.size() <= 2 || posterior > options.guessMostProbableAbove)
+    {
+        DigitCombination guess = weighted.mostProbable();
+        return evaluateWeightedHistogram(guess, weighted.histogram(guess));
+    }
+
+    const CombinationList& guesses = levelData(level).combinations;
+    GuessEvaluation best;
+    double bestWin = 0.0;
+    for (std::size_t g = 0; g < guesses.size(); g++)
+    {
+        WeightedHistogram histogram = weighted.histogram(g);
+        GuessEvaluation evaluation = evaluateWeightedHistogram(guesses[g], histogram);
+        double win = histogram.weights[NUM_OUTCOMES - 1];
+        if (g == 0 || isBetterBayesian(evaluation, win, best, bestWin))
+        {
+            best = evaluation;
+            bestWin = win;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "digitmind.h"
+#include "secret_prior.h"
+#include "strategy.h"
+
+/**
+ * Settings of the Bayesian guess selection.
+ */
+struct BayesianOptions
+{
+    double guessMostProbableAbove = 0.5;    // Posterior above which the most probable candidate is guessed
+};
+
+/**
+ * @brief Searches for the guess with the most information under a prior.
+ *
+ * The candidates are weighted by their prior, so the posterior of a candidate
+ * is its weight divided by the total weight of the candidates. Every
+ * combination of the level is evaluated by the entropy of its score under
+ * the posterior; equally informative guesses are ranked by whether they can
+ * be the code and then by their posterior. Priors generally tell digits
+ * apart, so guesses that differ by interchangeable digits are all evaluated.
+ *
+ * When the most probable candidate is more likely than the threshold, or at
+ * most two candidates are left, it is guessed directly: it wins the game
+ * with that probability, which outweighs the information of any other guess.
+ *
+ * @param level The difficulty level of the game.
+ * @param candidates The combinations that are still possible; not empty.
+ * @param prior The prior of the level.
+ * @param options The settings of the selection.
+ * @return The evaluation of the selected guess under the posterior.
+ */
+GuessEvaluation searchBayesian(int level, const CombinationList& candidates, const SecretPrior& prior,
+                               const BayesianOptions& options = BayesianOptions());
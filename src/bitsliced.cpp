@@ -0,0 +1,228 @@
+#include "bitsliced.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+
+/**
+ * @brief Adds four one-bit numbers per bit lane into a three-bit sum.
+ */
+void addFour(std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t d, std::uint64_t sum[3])
+{
+    std::uint64_t sumAB = a ^ b;
+    std::uint64_t carryAB = a & b;
+    std::uint64_t sumCD = c ^ d;
+    std::uint64_t carryCD = c & d;
+    std::uint64_t carry = sumAB & sumCD;
+
+    sum[0] = sumAB ^ sumCD;
+    sum[1] = carryAB ^ carryCD ^ carry;
+    sum[2] = (carryAB & carryCD) | ((carryAB ^ carryCD) & carry);
+}
+
+/**
+ * @brief Transposes a matrix of 8 x 8 bits, held one row per byte: bit j of
+ * byte i moves to bit i of byte j.
+ */
+std::uint64_t transposeBits(std::uint64_t x)
+{
+    std::uint64_t t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aa;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000cccc;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0;
+    return x ^ t ^ (t << 28);
+}
+
+/**
+ * @brief The outcome index of a candidate code with the right-position count
+ * in bits 0..2, the shared-digit count in bits 3..5 and the live bit in bit 6;
+ * codes of dead candidates give NUM_OUTCOMES.
+ */
+const std::array<std::uint8_t, 128>& codeOutcomes()
+{
+    static const std::array<std::uint8_t, 128> outcomes = []()
+    {
+        std::array<std::uint8_t, 128> table;
+        table.fill(NUM_OUTCOMES);
+        for (int right = 0; right <= 4; right++)
+        {
+            for (int shared = right; shared <= 4; shared++)
+            {
+                table[64 | shared << 3 | right] = MATCH_OUTCOMES[matchCode(right, shared)];
+            }
+        }
+        return table;
+    }();
+    return outcomes;
+}
+
+} // namespace
+
+BitSlicedCandidates::BitSlicedCandidates(const CombinationList& candidates)
+{
+    build(candidates);
+}
+
+void BitSlicedCandidates::build(const CombinationList& candidates)
+{
+    codes = candidates;
+    words = (codes.size() + 63) / 64;
+    planes.assign(4 * 10 * words, 0);
+    presence.assign(10 * words, 0);
+    alive.assign(words, 0);
+
+    for (std::size_t i = 0; i < codes.size(); i++)
+    {
+        std::uint64_t bit = std::uint64_t{1} << (i % 64);
+        std::size_t word = i / 64;
+        for (int position = 0; position < 4; position++)
+        {
+            int digit = codes[i][position];
+            planes[(position * 10 + digit) * words + word] |= bit;
+            presence[digit * words + word] |= bit;
+        }
+        alive[word] |= bit;
+    }
+}
+
+std::size_t BitSlicedCandidates::size() const
+{
+    std::size_t total = 0;
+    for (std::uint64_t word : alive)
+    {
+        total += std::popcount(word);
+    }
+    return total;
+}
+
+BitSlicedCandidates::Counts BitSlicedCandidates::count(const DigitCombination& guess, std::size_t word) const
+{
+    Counts counts;
+    addFour(plane(0, guess[0])[word], plane(1, guess[1])[word],
+            plane(2, guess[2])[word], plane(3, guess[3])[word], counts.right);
+    addFour(presence[guess[0] * words + word], presence[guess[1] * words + word],
+            presence[guess[2] * words + word], presence[guess[3] * words + word], counts.shared);
+    return counts;
+}
+
+std::uint64_t BitSlicedCandidates::equals(const std::uint64_t bits[3], int value)
+{
+    // A count of four bits is at most 4; the three bits of a larger value
+    // would match a smaller count
+    if (value < 0 || value > 4)
+    {
+        return 0;
+    }
+    return ((value & 1) ? bits[0] : ~bits[0])
+           & ((value & 2) ? bits[1] : ~bits[1])
+           & ((value & 4) ? bits[2] : ~bits[2]);
+}
+
+OutcomeHistogram BitSlicedCandidates::histogram(const DigitCombination& guess) const
+{
+    OutcomeHistogram histogram{};
+    for (std::size_t word = 0; word < words; word++)
+    {
+        if (alive[word] == 0)
+        {
+            continue;
+        }
+
+        // Masks of the candidates with each right and shared count
+        Counts counts = count(guess, word);
+        std::uint64_t right[5];
+        std::uint64_t shared[5];
+        for (int value = 0; value <= 4; value++)
+        {
+            right[value] = equals(counts.right, value) & alive[word];
+            shared[value] = equals(counts.shared, value);
+        }
+
+        for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+        {
+            Score score = outcomeScore(outcome);
+            int sharedCount = score.right_position + score.wrong_position;
+            histogram[outcome] += std::popcount(right[score.right_position] & shared[sharedCount]);
+        }
+    }
+    return histogram;
+}
+
+std::array<std::uint64_t, NUM_OUTCOMES> BitSlicedCandidates::groupHistogram(const DigitCombination& guess,
+                                                                           const std::uint8_t* shifts) const
+{
+    // Dead candidates add to a spare outcome
+    const std::array<std::uint8_t, 128>& outcomes = codeOutcomes();
+    std::uint64_t packed[NUM_OUTCOMES + 1] = {};
+    for (std::size_t word = 0; word < words; word++)
+    {
+        if (alive[word] == 0)
+        {
+            continue;
+        }
+
+        // Transpose the counts and live bits of eight candidates at a time into a byte each
+        Counts counts = count(guess, word);
+        const std::uint64_t bits[7] = {counts.right[0], counts.right[1], counts.right[2],
+                                       counts.shared[0], counts.shared[1], counts.shared[2], alive[word]};
+        for (int byte = 0; byte < 8; byte++)
+        {
+            if (((alive[word] >> (8 * byte)) & 0xff) == 0)
+            {
+                continue;
+            }
+
+            std::uint64_t rows = 0;
+            for (int plane = 0; plane < 7; plane++)
+            {
+                rows |= ((bits[plane] >> (8 * byte)) & 0xff) << (8 * plane);
+            }
+            std::uint64_t codes = transposeBits(rows);
+            const std::uint8_t* byteShifts = shifts + word * 64 + byte * 8;
+            for (int k = 0; k < 8; k++)
+            {
+                packed[outcomes[(codes >> (8 * k)) & 0x7f]] += std::uint64_t{1} << byteShifts[k];
+            }
+        }
+    }
+
+    std::array<std::uint64_t, NUM_OUTCOMES> histogram;
+    std::copy(packed, packed + NUM_OUTCOMES, histogram.begin());
+    return histogram;
+}
+
+void BitSlicedCandidates::filter(const DigitCombination& guess, const Score& score)
+{
+    int sharedCount = score.right_position + score.wrong_position;
+    for (std::size_t word = 0; word < words; word++)
+    {
+        if (alive[word] == 0)
+        {
+            continue;
+        }
+
+        Counts counts = count(guess, word);
+        alive[word] &= equals(counts.right, score.right_position) & equals(counts.shared, sharedCount);
+    }
+}
+
+void BitSlicedCandidates::compact()
+{
+    build(combinations());
+}
+
+CombinationList BitSlicedCandidates::combinations() const
+{
+    CombinationList live;
+    for (std::size_t word = 0; word < words; word++)
+    {
+        for (std::uint64_t bits = alive[word]; bits != 0; bits &= bits - 1)
+        {
+            live.push_back(codes[word * 64 + std::countr_zero(bits)]);
+        }
+    }
+    return live;
+}
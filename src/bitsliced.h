@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * @brief A set of candidates stored as bitplanes, scored 64 at a time.
+ *
+ * For every position and digit, a bitplane has a bit set for each candidate
+ * with that digit at that position, and for every digit a presence plane has
+ * a bit set for each candidate containing the digit. For a guess, the planes
+ * of its four (position, digit) pairs mark the candidates with a right
+ * position and the presence planes of its four digits mark the candidates
+ * sharing a digit. Adding these four bits per candidate with bitwise adders
+ * gives the right and shared counts of 64 candidates per word, from which
+ * the scores follow (wrong = shared - right) without a per-candidate loop.
+ *
+ * Filtering clears the bits of the candidates that do not match in a mask of
+ * live candidates; compact() rebuilds the planes when few are left.
+ */
+class BitSlicedCandidates
+{
+public:
+    /**
+     * @param candidates The candidates to store.
+     */
+    explicit BitSlicedCandidates(const CombinationList& candidates);
+
+    /**
+     * @brief Returns the number of live candidates.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the number of candidates the planes have room for, live or not.
+     */
+    std::size_t capacity() const
+    {
+        return codes.size();
+    }
+
+    /**
+     * @brief Counts the live candidates giving each score for a guess.
+     */
+    OutcomeHistogram histogram(const DigitCombination& guess) const;
+
+    /**
+     * @brief Counts the live candidates giving each score for a guess within
+     * each of up to eight groups of candidates.
+     *
+     * @param guess The guess.
+     * @param shifts For every candidate, eight times its group; wordCount() * 64
+     * entries, those past the candidates being ignored.
+     * @return For every score, a word whose byte g counts the candidates of
+     * group g; there must be fewer than 256 candidates.
+     */
+    std::array<std::uint64_t, NUM_OUTCOMES> groupHistogram(const DigitCombination& guess,
+                                                           const std::uint8_t* shifts) const;
+
+    /**
+     * @brief Removes the candidates that do not give the score for the guess.
+     */
+    void filter(const DigitCombination& guess, const Score& score);
+
+    /**
+     * @brief Rebuilds the planes from the live candidates only.
+     */
+    void compact();
+
+    /**
+     * @brief Returns the live candidates in their original order.
+     */
+    CombinationList combinations() const;
+
+    /**
+     * @brief Returns the number of words of every plane.
+     */
+    std::size_t wordCount() const
+    {
+        return words;
+    }
+
+    /**
+     * @brief Returns the mask of the live candidates of a word.
+     */
+    std::uint64_t live(std::size_t word) const
+    {
+        return alive[word];
+    }
+
+    /**
+     * @brief Returns candidate i of the planes, live or not.
+     */
+    const DigitCombination& combination(std::size_t i) const
+    {
+        return codes[i];
+    }
+
+private:
+    struct Counts
+    {
+        std::uint64_t right[3];     // Bits 0..2 of the right-position count
+        std::uint64_t shared[3];    // Bits 0..2 of the shared-digit count
+    };
+
+    void build(const CombinationList& candidates);
+    Counts count(const DigitCombination& guess, std::size_t word) const;
+    static std::uint64_t equals(const std::uint64_t bits[3], int value);
+
+    const std::uint64_t* plane(int position, int digit) const
+    {
+        return &planes[(position * 10 + digit) * words];
+    }
+
+    CombinationList codes;
+    std::size_t words;
+    std::vector<std::uint64_t> planes;      // 4 x 10 planes of `words` words
+    std::vector<std::uint64_t> presence;    // 10 planes of `words` words
+    std::vector<std::uint64_t> alive;
+};
@@ -0,0 +1,90 @@
+#include "cache_file.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::string cacheFilePath(const std::string& name)
+{
+    const char* directory = std::getenv("DIGITMIND_CACHE_DIR");
+    std::string path = directory != nullptr && *directory != '\0' ? std::string(directory) + "/" : "";
+    return path + name;
+}
+
+bool writeCacheFile(const std::string& path, const std::function<void(std::ostream&)>& write)
+{
+    std::string temporaryPath = path + ".tmp" + std::to_string(getpid());
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    write(file);
+
+    // Closing flushes the last writes, which can fail as well
+    file.close();
+    if (!file)
+    {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+MappedFile::MappedFile(void* mapping, std::size_t mappingSize)
+    : mapping(mapping), mappingSize(mappingSize)
+{
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)),
+      mappingSize(std::exchange(other.mappingSize, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    std::swap(mapping, other.mapping);
+    std::swap(mappingSize, other.mappingSize);
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mappingSize);
+    }
+}
+
+std::optional<MappedFile> MappedFile::open(const std::string& path, std::size_t minimumSize)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < minimumSize)
+    {
+        close(fd);
+        return std::nullopt;
+    }
+
+    std::size_t size = status.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return std::nullopt;
+    }
+    return MappedFile(mapping, size);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Returns the path of a cache file.
+ *
+ * The cache files (solution stores, level tables and difficulty tables) are
+ * located in the directory given by the `DIGITMIND_CACHE_DIR` environment
+ * variable, or in the working directory when it is not set.
+ *
+ * @param name The name of the file.
+ */
+std::string cacheFilePath(const std::string& name);
+
+/**
+ * @brief Writes a cache file under a temporary name and then renames it.
+ *
+ * Processes mapping the old file keep a consistent view and never map a
+ * partially written one. Processes writing the same file at the same time
+ * write their own temporary file.
+ *
+ * @param path The path of the file.
+ * @param write Writes the contents of the file to the stream.
+ * @return Whether the file was written, including closing it, and renamed.
+ */
+bool writeCacheFile(const std::string& path, const std::function<void(std::ostream&)>& write);
+
+/**
+ * @brief A whole file mapped read-only into memory.
+ *
+ * The pages are shared by all processes mapping the same file. The mapping is
+ * released when the object is destroyed.
+ */
+class MappedFile
+{
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    /**
+     * @brief Maps a file.
+     *
+     * @param path The path of the file.
+     * @param minimumSize The size below which the file is not mapped, such as
+     * the size of its header.
+     * @return The mapping, or nothing when the file does not exist, is smaller
+     * than the minimum size or could not be mapped.
+     */
+    static std::optional<MappedFile> open(const std::string& path, std::size_t minimumSize);
+
+    const void* data() const { return mapping; }
+
+    /**
+     * @brief Returns the size of the file in bytes.
+     */
+    std::size_t size() const { return mappingSize; }
+
+private:
+    MappedFile(void* mapping, std::size_t mappingSize);
+
+    void* mapping;
+    std::size_t mappingSize;
+};
@@ -0,0 +1,47 @@
+#include "candidate_set.h"
+
+CandidateSet::CandidateSet(const CombinationList& candidates, const CandidateSetOptions& options)
+    : options(options), store(std::in_place_type<BitSlicedCandidates>, candidates)
+{
+    adapt();
+}
+
+std::size_t CandidateSet::size() const
+{
+    return std::visit([](const auto& candidates) { return candidates.size(); }, store);
+}
+
+OutcomeHistogram CandidateSet::histogram(const DigitCombination& guess) const
+{
+    return std::visit([&](const auto& candidates) { return candidates.histogram(guess); }, store);
+}
+
+void CandidateSet::filter(const DigitCombination& guess, const Score& score)
+{
+    std::visit([&](auto& candidates) { candidates.filter(guess, score); }, store);
+    adapt();
+}
+
+CombinationList CandidateSet::combinations() const
+{
+    return std::visit([](const auto& candidates) { return candidates.combinations(); }, store);
+}
+
+void CandidateSet::adapt()
+{
+    auto* planes = std::get_if<BitSlicedCandidates>(&store);
+    if (planes == nullptr)
+    {
+        return;
+    }
+
+    std::size_t live = planes->size();
+    if (live < options.arraysBelow)
+    {
+        store.emplace<SoACandidates>(planes->combinations());
+    }
+    else if (live < options.compactBelow * planes->capacity())
+    {
+        planes->compact();
+    }
+}
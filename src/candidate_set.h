@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <variant>
+
+#include "bitsliced.h"
+#include "digitmind.h"
+#include "soa_candidates.h"
+#include "strategy.h"
+
+/**
+ * Thresholds at which a CandidateSet changes its representation.
+ *
+ * The defaults follow the crossover points measured by DigitMindBenchmark:
+ * bit-sliced scoring is the fastest down to a handful of candidates at every
+ * level, below which scoring a short array is as fast and smaller.
+ */
+struct CandidateSetOptions
+{
+    std::size_t arraysBelow = 8;    // Candidates below which the arrays are used
+    double compactBelow = 0.25;     // Live fraction of the bitplanes below which they are rebuilt
+};
+
+/**
+ * @brief A set of candidates that picks its representation by its size.
+ *
+ * A large set is held in bitplanes (BitSlicedCandidates), which score 64
+ * candidates per word; when filtering leaves few live candidates in the
+ * planes, they are compacted, and once the set is smaller than a threshold it
+ * moves to plain arrays (SoACandidates). Callers only see the operations
+ * common to all representations.
+ */
+class CandidateSet
+{
+public:
+    enum class Representation
+    {
+        BitSliced,
+        Arrays
+    };
+
+    /**
+     * @param candidates The candidates, in generation order.
+     * @param options The thresholds at which to change representation.
+     */
+    explicit CandidateSet(const CombinationList& candidates,
+                          const CandidateSetOptions& options = CandidateSetOptions());
+
+    /**
+     * @brief Returns the number of candidates.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Counts the candidates giving each score for a guess.
+     */
+    OutcomeHistogram histogram(const DigitCombination& guess) const;
+
+    /**
+     * @brief Removes the candidates that do not give the score for the guess,
+     * like filterCombinations().
+     */
+    void filter(const DigitCombination& guess, const Score& score);
+
+    /**
+     * @brief Returns the candidates in generation order.
+     */
+    CombinationList combinations() const;
+
+    Representation representation() const
+    {
+        return std::holds_alternative<BitSlicedCandidates>(store) ? Representation::BitSliced
+                                                                  : Representation::Arrays;
+    }
+
+private:
+    /**
+     * @brief Changes the representation when the size crossed a threshold.
+     */
+    void adapt();
+
+    CandidateSetOptions options;
+    std::variant<BitSlicedCandidates, SoACandidates> store;
+};
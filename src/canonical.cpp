@@ -0,0 +1,104 @@
+#include "canonical.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+// A transformed move flattened for lexicographic comparison
+typedef std::array<int, 6> MoveKey;
+
+/**
+ * @brief Creates the symmetry that relabels the digits by first appearance.
+ */
+Symmetry relabelByAppearance(int level, const GameHistory& history, const std::vector<int>& order,
+                             const std::array<int, 4>& positions)
+{
+    Symmetry symmetry;
+    symmetry.positions = positions;
+    symmetry.digits.fill(-1);
+
+    int next = 0;
+    for (int m : order)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            int digit = history[m].guess[positions[i]];
+            if (symmetry.digits[digit] < 0)
+            {
+                symmetry.digits[digit] = next++;
+            }
+        }
+    }
+
+    // Digits that were never guessed are interchangeable, keep their order
+    for (int digit = 0; digit < 10; digit++)
+    {
+        if (symmetry.digits[digit] < 0)
+        {
+            symmetry.digits[digit] = digit < level ? next++ : digit;
+        }
+    }
+    return symmetry;
+}
+
+void transformHistory(const Symmetry& symmetry, const GameHistory& history, const std::vector<int>& order,
+                      std::vector<MoveKey>& keys)
+{
+    keys.clear();
+    for (int m : order)
+    {
+        DigitCombination guess = symmetry.apply(history[m].guess);
+        keys.push_back(MoveKey{guess[0], guess[1], guess[2], guess[3],
+                               history[m].score.right_position, history[m].score.wrong_position});
+    }
+}
+
+} // namespace
+
+CanonicalState canonicalize(int level, const GameHistory& history, const CombinationList& candidates)
+{
+    std::vector<int> order(history.size());
+    std::iota(order.begin(), order.end(), 0);
+    bool permuteMoves = history.size() <= MAX_PERMUTED_MOVES;
+
+    Symmetry best;
+    std::vector<int> bestOrder = order;
+    std::vector<MoveKey> bestKeys;
+    std::vector<MoveKey> keys;
+    bool found = false;
+    do
+    {
+        std::array<int, 4> positions = {0, 1, 2, 3};
+        do
+        {
+            Symmetry symmetry = relabelByAppearance(level, history, order, positions);
+            transformHistory(symmetry, history, order, keys);
+            if (!found || keys < bestKeys)
+            {
+                best = symmetry;
+                bestOrder = order;
+                bestKeys.swap(keys);
+                found = true;
+            }
+        } while (std::next_permutation(positions.begin(), positions.end()));
+    } while (permuteMoves && std::next_permutation(order.begin(), order.end()));
+
+    CanonicalState state;
+    state.symmetry = best;
+    for (int m : bestOrder)
+    {
+        state.history.push_back(Move{best.apply(history[m].guess), history[m].score});
+    }
+
+    // Transformed codes are sorted back into the order of generateAllCombinations()
+    state.candidates.reserve(candidates.size());
+    for (const DigitCombination& code : candidates)
+    {
+        state.candidates.push_back(best.apply(code));
+    }
+    std::sort(state.candidates.begin(), state.candidates.end());
+    return state;
+}
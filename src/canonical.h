@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+
+#include "digitmind.h"
+
+/**
+ * @brief A symmetry of the game: a permutation of the positions combined with
+ * a relabeling of the digits.
+ *
+ * Applying the same symmetry to a guess and a code does not change their
+ * score, so a game history and its candidate set can be transformed together
+ * without changing the game.
+ */
+struct Symmetry
+{
+    std::array<int, 4> positions;   // Position of the original moved to each position
+    std::array<int, 10> digits;     // New label of each original digit
+
+    Symmetry() : positions{0, 1, 2, 3}, digits{0, 1, 2, 3, 4, 5, 6, 7, 8, 9} {}
+
+    /**
+     * @brief Transforms a combination from the original to the new labeling.
+     */
+    DigitCombination apply(const DigitCombination& combination) const
+    {
+        DigitCombination result;
+        for (int i = 0; i < 4; i++)
+        {
+            result[i] = digits[combination[positions[i]]];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Transforms a combination from the new back to the original labeling.
+     */
+    DigitCombination invert(const DigitCombination& combination) const
+    {
+        std::array<int, 10> originalDigits;
+        for (int d = 0; d < 10; d++)
+        {
+            originalDigits[digits[d]] = d;
+        }
+
+        DigitCombination result;
+        for (int i = 0; i < 4; i++)
+        {
+            result[positions[i]] = originalDigits[combination[i]];
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief A game state in canonical form.
+ */
+struct CanonicalState
+{
+    Symmetry symmetry;          // Maps the original state onto the canonical one
+    GameHistory history;        // The transformed history
+    CombinationList candidates; // The transformed candidate set, in generation order
+};
+
+/**
+ * The maximum number of moves whose orders are all tried by canonicalize();
+ * the moves of longer histories are taken in the order they were made.
+ */
+const int MAX_PERMUTED_MOVES = 5;
+
+/**
+ * @brief Brings a game state into canonical form.
+ *
+ * Game states that differ only by a relabeling of the digits, a permutation
+ * of the positions or the order of the moves have the same canonical form, so
+ * the canonical candidate set can be used as a cache key that is shared by all
+ * of them. A result computed for the canonical state, such as the best guess,
+ * is mapped back to the original state with `symmetry.invert()`.
+ *
+ * The canonical form is the smallest transformed history: for every order of
+ * the moves (up to MAX_PERMUTED_MOVES moves) and every permutation of the
+ * positions, the digits are relabeled in order of their first appearance in
+ * the guesses, the remaining digits keeping their relative order.
+ *
+ * @note States with different histories are not recognized as isomorphic,
+ * even when their candidate sets are; those states simply miss the cache.
+ *
+ * @param level The difficulty level of the game.
+ * @param history The moves that led to the state.
+ * @param candidates The combinations that are still possible after the moves.
+ * @return The canonical form of the state.
+ */
+CanonicalState canonicalize(int level, const GameHistory& history, const CombinationList& candidates);
@@ -0,0 +1,62 @@
+#include "compiled_history.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+
+/** The longest history compiled into one predicate. */
+const std::size_t MAX_COMPILED_MOVES = 16;
+
+template <std::size_t Moves>
+void filterCompiled(CombinationList& combinations, const Move* moves)
+{
+    CompiledHistory<Moves> consistent(moves);
+    std::erase_if(combinations, [&](const DigitCombination& code)
+    {
+        return !consistent(code);
+    });
+}
+
+typedef void (*CompiledFilter)(CombinationList&, const Move*);
+
+/**
+ * @brief Returns the filters specialized on 1 to MAX_COMPILED_MOVES moves,
+ * indexed by the number of moves minus 1.
+ */
+template <std::size_t... Indices>
+constexpr std::array<CompiledFilter, sizeof...(Indices)> makeFilters(std::index_sequence<Indices...>)
+{
+    return {&filterCompiled<Indices + 1>...};
+}
+
+const std::array<CompiledFilter, MAX_COMPILED_MOVES> FILTERS =
+    makeFilters(std::make_index_sequence<MAX_COMPILED_MOVES>());
+
+} // namespace
+
+CombinationList filterByHistory(const CombinationList& combinations, const GameHistory& history)
+{
+    CombinationList consistent = combinations;
+    std::size_t first = 0;
+    while (first < history.size())
+    {
+        if (!isCompilable(history[first]))
+        {
+            filterCombinations(consistent, history[first].guess, history[first].score);
+            first++;
+            continue;
+        }
+
+        // Compile the run of compilable moves starting here
+        std::size_t moves = 1;
+        while (moves < MAX_COMPILED_MOVES && first + moves < history.size() && isCompilable(history[first + moves]))
+        {
+            moves++;
+        }
+        FILTERS[moves - 1](consistent, &history[first]);
+        first += moves;
+    }
+    return consistent;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "digitmind.h"
+
+/**
+ * @brief Returns whether a move can be compiled into a CompiledHistory: its
+ * guess must have four distinct digits below 10 and its score must be one a
+ * guess can receive.
+ *
+ * The match codes only identify the score for such guesses, and an impossible
+ * score could alias the code of another one.
+ */
+inline bool isCompilable(const Move& move)
+{
+    for (int digit : move.guess)
+    {
+        if (digit < 0 || digit >= 10)
+        {
+            return false;
+        }
+    }
+    const Score& score = move.score;
+    return std::popcount(digitMask(move.guess)) == 4
+           && score.right_position >= 0 && score.wrong_position >= 0
+           && score.right_position + score.wrong_position <= 4
+           && MATCH_OUTCOMES[matchCode(score)] != NUM_OUTCOMES;
+}
+
+/**
+ * @brief The moves of a game compiled into a branch-free predicate that tells
+ * whether a combination is consistent with all of them.
+ *
+ * For a guess, the matchCode() of the right positions and shared digits
+ * identifies the score, and every digit of a candidate contributes to it independently:
+ * 5 when it is the guess's digit at its position, plus 1 when the guess
+ * contains it. The contributions are precomputed per (position, digit) for
+ * every move, one byte per move, packed 8 moves to a word. A candidate's
+ * codes for all moves are then the sums of four words per 8 moves (at most
+ * 4 * 6 per byte, so the bytes never carry), and it is consistent when they
+ * equal the codes of the scores received. No candidate is scored and the
+ * evaluation has no branches.
+ *
+ * Every move must be compilable (isCompilable()), and the combinations tested
+ * must have distinct digits below 10, as generateAllCombinations() makes them.
+ *
+ * @tparam Moves The number of moves; the predicate is specialized on it.
+ */
+template <std::size_t Moves>
+class CompiledHistory
+{
+public:
+    static_assert(Moves > 0, "a history without moves accepts every combination");
+
+    /** The number of words of packed codes. */
+    static const std::size_t WORDS = (Moves + 7) / 8;
+
+    /**
+     * @param moves The first `Moves` moves of the game, which must all be
+     * compilable.
+     */
+    explicit CompiledHistory(const Move* moves)
+        : contributions{}, expected{}
+    {
+        for (std::size_t move = 0; move < Moves; move++)
+        {
+            assert(isCompilable(moves[move]));
+            const DigitCombination& guess = moves[move].guess;
+            const Score& score = moves[move].score;
+            std::size_t word = move / 8;
+            int shift = static_cast<int>(move % 8) * 8;
+
+            for (int position = 0; position < 4; position++)
+            {
+                for (int digit = 0; digit < 10; digit++)
+                {
+                    bool shared = guess[0] == digit || guess[1] == digit || guess[2] == digit || guess[3] == digit;
+                    std::uint64_t contribution = matchCode(guess[position] == digit, shared);
+                    contributions[position * 10 + digit][word] |= contribution << shift;
+                }
+            }
+
+            std::uint64_t code = matchCode(score);
+            expected[word] |= code << shift;
+        }
+    }
+
+    /**
+     * @brief Returns whether a combination gives every move its score.
+     */
+    bool operator()(const DigitCombination& code) const
+    {
+        const auto& digit0 = contributions[code[0]];
+        const auto& digit1 = contributions[10 + code[1]];
+        const auto& digit2 = contributions[20 + code[2]];
+        const auto& digit3 = contributions[30 + code[3]];
+
+        std::uint64_t difference = 0;
+        for (std::size_t word = 0; word < WORDS; word++)
+        {
+            difference |= (digit0[word] + digit1[word] + digit2[word] + digit3[word]) ^ expected[word];
+        }
+        return difference == 0;
+    }
+
+private:
+    std::array<std::array<std::uint64_t, WORDS>, 4 * 10> contributions;
+    std::array<std::uint64_t, WORDS> expected;
+};
+
+/**
+ * @brief Returns the combinations that are consistent with all moves of a history.
+ *
+ * The history is compiled into a CompiledHistory specialized on its length;
+ * histories longer than the largest specialization are compiled in parts.
+ * Moves that are not compilable (isCompilable()) are applied with
+ * filterCombinations() instead. For combinations of distinct digits below 10
+ * the result equals applying filterCombinations() for every move.
+ *
+ * @param combinations The combinations to filter.
+ * @param history The moves of the game.
+ * @return The consistent combinations, in the order of `combinations`.
+ */
+CombinationList filterByHistory(const CombinationList& combinations, const GameHistory& history);
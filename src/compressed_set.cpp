@@ -0,0 +1,187 @@
+#include "compressed_set.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+CompressedSet CompressedSet::all(std::size_t count)
+{
+    std::vector<std::uint64_t> bits((count + 63) / 64, ~std::uint64_t{0});
+    if (count % 64 != 0)
+    {
+        bits.back() = (std::uint64_t{1} << (count % 64)) - 1;
+    }
+    return fromBitset(bits.data(), bits.size());
+}
+
+CompressedSet CompressedSet::fromBitset(const std::uint64_t* bits, std::size_t words)
+{
+    CompressedSet set;
+    set.words = words;
+    std::size_t chunkCount = (words + CHUNK_WORDS - 1) / CHUNK_WORDS;
+    for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        set.addChunk(static_cast<std::uint16_t>(chunk), set.loadChunk(bits, static_cast<std::uint16_t>(chunk)));
+    }
+    return set;
+}
+
+CompressedSet::ChunkBits CompressedSet::loadChunk(const std::uint64_t* bits, std::uint16_t chunk) const
+{
+    ChunkBits chunkBits{};
+    std::size_t first = chunk * CHUNK_WORDS;
+    std::copy(bits + first, bits + std::min(first + CHUNK_WORDS, words), chunkBits.begin());
+    return chunkBits;
+}
+
+CompressedSet::ChunkBits CompressedSet::containerBits(std::size_t i) const
+{
+    ChunkBits bits{};
+    if (counts[i] == CHUNK_SIZE)
+    {
+        bits.fill(~std::uint64_t{0});
+    }
+    else if (counts[i] > ARRAY_LIMIT)
+    {
+        std::copy(&data[starts[i]], &data[starts[i]] + CHUNK_WORDS, bits.begin());
+    }
+    else
+    {
+        auto offsets = reinterpret_cast<const std::uint8_t*>(&data[starts[i]]);
+        for (std::size_t j = 0; j < counts[i]; j++)
+        {
+            bits[offsets[j] / 64] |= std::uint64_t{1} << (offsets[j] % 64);
+        }
+    }
+    return bits;
+}
+
+void CompressedSet::addChunk(std::uint16_t chunk, const ChunkBits& bits)
+{
+    std::size_t members = 0;
+    for (std::uint64_t word : bits)
+    {
+        members += std::popcount(word);
+    }
+    if (members == 0)
+    {
+        return;
+    }
+
+    chunks.push_back(chunk);
+    counts.push_back(static_cast<std::uint16_t>(members));
+    starts.push_back(static_cast<std::uint32_t>(data.size()));
+    count += members;
+
+    if (members == CHUNK_SIZE)
+    {
+        return;
+    }
+    if (members > ARRAY_LIMIT)
+    {
+        data.insert(data.end(), bits.begin(), bits.end());
+        return;
+    }
+
+    std::uint8_t offsets[ARRAY_LIMIT];
+    std::size_t next = 0;
+    for (std::size_t word = 0; word < CHUNK_WORDS; word++)
+    {
+        for (std::uint64_t rest = bits[word]; rest != 0; rest &= rest - 1)
+        {
+            offsets[next++] = static_cast<std::uint8_t>(word * 64 + std::countr_zero(rest));
+        }
+    }
+    std::size_t start = data.size();
+    data.resize(start + (members + 7) / 8);
+    std::memcpy(&data[start], offsets, members);
+}
+
+bool CompressedSet::contains(std::size_t id) const
+{
+    auto it = std::lower_bound(chunks.begin(), chunks.end(), id / CHUNK_SIZE);
+    if (it == chunks.end() || *it != id / CHUNK_SIZE)
+    {
+        return false;
+    }
+
+    std::size_t i = it - chunks.begin();
+    std::size_t offset = id % CHUNK_SIZE;
+    if (counts[i] == CHUNK_SIZE)
+    {
+        return true;
+    }
+    if (counts[i] > ARRAY_LIMIT)
+    {
+        return (data[starts[i] + offset / 64] >> (offset % 64)) & 1;
+    }
+    auto offsets = reinterpret_cast<const std::uint8_t*>(&data[starts[i]]);
+    return std::binary_search(offsets, offsets + counts[i], static_cast<std::uint8_t>(offset));
+}
+
+std::vector<std::uint16_t> CompressedSet::ids() const
+{
+    std::vector<std::uint16_t> ids;
+    ids.reserve(count);
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        std::size_t base = chunks[i] * CHUNK_SIZE;
+        ChunkBits bits = containerBits(i);
+        for (std::size_t word = 0; word < CHUNK_WORDS; word++)
+        {
+            for (std::uint64_t rest = bits[word]; rest != 0; rest &= rest - 1)
+            {
+                ids.push_back(static_cast<std::uint16_t>(base + word * 64 + std::countr_zero(rest)));
+            }
+        }
+    }
+    return ids;
+}
+
+CompressedSet CompressedSet::intersect(const std::uint64_t* bits) const
+{
+    CompressedSet result;
+    result.words = words;
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        ChunkBits chunkBits = containerBits(i);
+        ChunkBits other = loadChunk(bits, chunks[i]);
+        for (std::size_t word = 0; word < CHUNK_WORDS; word++)
+        {
+            chunkBits[word] &= other[word];
+        }
+        result.addChunk(chunks[i], chunkBits);
+    }
+    return result;
+}
+
+std::size_t CompressedSet::intersectionCardinality(const std::uint64_t* bits) const
+{
+    std::size_t members = 0;
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        ChunkBits other = loadChunk(bits, chunks[i]);
+        if (counts[i] > ARRAY_LIMIT)
+        {
+            ChunkBits chunkBits = containerBits(i);
+            for (std::size_t word = 0; word < CHUNK_WORDS; word++)
+            {
+                members += std::popcount(chunkBits[word] & other[word]);
+            }
+            continue;
+        }
+
+        auto offsets = reinterpret_cast<const std::uint8_t*>(&data[starts[i]]);
+        for (std::size_t j = 0; j < counts[i]; j++)
+        {
+            members += (other[offsets[j] / 64] >> (offsets[j] % 64)) & 1;
+        }
+    }
+    return members;
+}
+
+std::size_t CompressedSet::bytes() const
+{
+    return chunks.size() * (sizeof(std::uint16_t) * 2 + sizeof(std::uint32_t))
+           + data.size() * sizeof(std::uint64_t);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A compressed set of candidate ids in the style of roaring bitmaps.
+ *
+ * The ids are split into chunks of CHUNK_SIZE consecutive ids, and only the
+ * chunks with at least one member are stored. A chunk with few members is an
+ * array container holding their sorted offsets in the chunk; a chunk with many
+ * members is a bitmap container holding one bit per id of the chunk, and a
+ * chunk with all ids as members holds nothing. The container type follows the
+ * member count, with the threshold where arrays and bitmaps take the same
+ * memory. Early in a game most chunks are dense bitmaps and late in a
+ * game most chunks are gone or short arrays, so the set stays small
+ * throughout.
+ *
+ * Partition sets (such as LevelTables::partition()) are plain bitsets over the
+ * same ids; intersecting with them and counting the intersection work chunk by
+ * chunk, a bitmap container a word at a time.
+ */
+class CompressedSet
+{
+public:
+    /** The number of ids per chunk. */
+    static const std::size_t CHUNK_SIZE = 256;
+
+    /** The largest member count stored as an array container. */
+    static const std::size_t ARRAY_LIMIT = CHUNK_SIZE / 8;
+
+    CompressedSet() = default;
+
+    /**
+     * @brief Returns the set of the ids [0, count).
+     */
+    static CompressedSet all(std::size_t count);
+
+    /**
+     * @brief Returns the set of the ids whose bits are set in a bitset.
+     *
+     * @param bits The bitset, of `words` words of 64 bits.
+     * @param words The number of words.
+     */
+    static CompressedSet fromBitset(const std::uint64_t* bits, std::size_t words);
+
+    /**
+     * @brief Returns the number of ids in the set.
+     */
+    std::size_t cardinality() const
+    {
+        return count;
+    }
+
+    bool contains(std::size_t id) const;
+
+    /**
+     * @brief Returns the ids of the set in increasing order.
+     */
+    std::vector<std::uint16_t> ids() const;
+
+    /**
+     * @brief Returns the ids of this set whose bits are set in a bitset.
+     *
+     * @param bits The bitset, of as many words as the bitset this set was
+     * created from.
+     */
+    CompressedSet intersect(const std::uint64_t* bits) const;
+
+    /**
+     * @brief Counts the ids of this set whose bits are set in a bitset.
+     *
+     * @param bits The bitset, of as many words as the bitset this set was
+     * created from.
+     */
+    std::size_t intersectionCardinality(const std::uint64_t* bits) const;
+
+    /**
+     * @brief Returns the memory used by the containers in bytes.
+     */
+    std::size_t bytes() const;
+
+private:
+    static const std::size_t CHUNK_WORDS = CHUNK_SIZE / 64;
+
+    typedef std::array<std::uint64_t, CHUNK_WORDS> ChunkBits;
+
+    /**
+     * @brief Returns the bits of container i.
+     */
+    ChunkBits containerBits(std::size_t i) const;
+
+    /**
+     * @brief Adds the container of a chunk from its bits, unless it is empty.
+     */
+    void addChunk(std::uint16_t chunk, const ChunkBits& bits);
+
+    /**
+     * @brief Returns the bits of a chunk of a bitset over the universe of this set.
+     */
+    ChunkBits loadChunk(const std::uint64_t* bits, std::uint16_t chunk) const;
+
+    // The containers in increasing order of chunk. A container of a full chunk
+    // has no data, a bitmap container has CHUNK_WORDS words and an array
+    // container has its sorted offsets packed as bytes into words.
+    std::vector<std::uint16_t> chunks;
+    std::vector<std::uint16_t> counts;
+    std::vector<std::uint32_t> starts;      // Index of the first word of the data of every container
+    std::vector<std::uint64_t> data;
+    std::size_t count = 0;
+    std::size_t words = 0;                  // Words of 64 bits of a bitset over all ids
+};
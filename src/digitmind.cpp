@@ -0,0 +1,126 @@
+#include "digitmind.h"
+
+#include <random> // for std::random_device and std::mt19937
+
+#include "filter_pipeline.h"
+
+Score calculateScore(DigitCombination guess, DigitCombination code)
+{
+    Score score;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (guess[i] == code[i])
+        {
+            // Correct digit at right position
+            score.right_position++;
+        }
+        else
+        {
+            // Check if guess digit is in code
+            for (int j = 0; j < 4; j++)
+            {
+                if (guess[i] == code[j])
+                {
+                    score.wrong_position++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return score;
+}
+
+int outcomeIndex(const Score& score)
+{
+    // Indexed by right_position * 5 + wrong_position
+    static const int indices[25] = {
+        0, 1, 2, 3, 4,
+        5, 6, 7, 8, -1,
+        9, 10, 11, -1, -1,
+        12, -1, -1, -1, -1,
+        13, -1, -1, -1, -1
+    };
+    return indices[score.right_position * 5 + score.wrong_position];
+}
+
+Score outcomeScore(int index)
+{
+    static const int rightPositions[NUM_OUTCOMES] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 3, 4};
+    static const int wrongPositions[NUM_OUTCOMES] = {0, 1, 2, 3, 4, 0, 1, 2, 3, 0, 1, 2, 0, 0};
+
+    Score score;
+    score.right_position = rightPositions[index];
+    score.wrong_position = wrongPositions[index];
+    return score;
+}
+
+CombinationList generateAllCombinations(int level)
+{
+    CombinationList allCombinations;
+
+    // Generate combinations from '0123' to 'level-1 level-1 level-1 level-1'
+    for (int i = 0; i < level; i++)
+    {
+        for (int j = 0; j < level; j++)
+        {
+            for (int k = 0; k < level; k++)
+            {
+                for (int l = 0; l < level; l++)
+                {
+                    if (i != j && i != k && i != l && j != k && j != l && k != l)
+                    {
+                        allCombinations.push_back(DigitCombination{i, j, k, l});
+                    }
+                }
+            }
+        }
+    }
+    return allCombinations;
+}
+
+bool isValidCombination(const DigitCombination& combination, int level)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (combination[i] < 0 || combination[i] >= level)
+        {
+            return false;
+        }
+        for (int j = 0; j < i; j++)
+        {
+            if (combination[i] == combination[j])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void filterCombinations(CombinationList& allCombinations,
+                        const DigitCombination& guess,
+                        const Score& score)
+{
+    // Remove the combinations that don't produce the same score, checking
+    // the shared digits before the positions when the guess allows it
+    if (FilterPipeline::supports(guess))
+    {
+        FilterPipeline pipeline(guess, score);
+        pipeline.filter(allCombinations);
+        return;
+    }
+    std::erase_if(allCombinations, [&](const DigitCombination& code)
+    {
+        return calculateScore(guess, code) != score;
+    });
+}
+
+DigitCombination selectRandomCombination(const CombinationList& combinations)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<CombinationList::size_type> dis(0, combinations.size() - 1);
+    return combinations[dis(gen)];
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+typedef std::array<int, 4> DigitCombination;
+typedef std::vector<DigitCombination> CombinationList;
+
+/**
+ * A read-only view of consecutive combinations, such as a whole
+ * CombinationList or one bucket of an OutcomePartition.
+ */
+typedef std::span<const DigitCombination> CombinationSpan;
+
+struct Score
+{
+    int right_position;
+    int wrong_position;
+
+    Score() : right_position(0), wrong_position(0) {}
+
+    // Overloading the equality operator
+    bool operator==(const Score &other) const
+    {
+        return right_position == other.right_position
+               && wrong_position == other.wrong_position;
+    }
+};
+
+/**
+ * A move of the game: a guess and the score it received.
+ */
+struct Move
+{
+    DigitCombination guess;
+    Score score;
+};
+
+/**
+ * The moves of a game in the order they were made.
+ */
+typedef std::vector<Move> GameHistory;
+
+/**
+ * The lowest and highest difficulty levels: the number of digits a
+ * combination is made of.
+ */
+const int MIN_LEVEL = 4;
+const int MAX_LEVEL = 10;
+
+/**
+ * The number of different scores a guess can receive: every combination of
+ * right and wrong positions adding up to at most 4, except 3 right and 1 wrong
+ * which cannot occur.
+ */
+const int NUM_OUTCOMES = 14;
+
+/**
+ * @brief Returns the digit mask of a combination: bit d is set when the
+ * combination contains digit d.
+ */
+inline unsigned digitMask(const DigitCombination& code)
+{
+    return (1u << code[0]) | (1u << code[1]) | (1u << code[2]) | (1u << code[3]);
+}
+
+/**
+ * The number of match codes, see matchCode().
+ */
+const int NUM_MATCH_CODES = 25;
+
+/**
+ * @brief Returns the match code of a number of right positions and shared
+ * digits: the right positions times 5 plus the shared digits.
+ *
+ * The score kernels count the right positions and the shared digits of a
+ * candidate, or add 5 per right position and 1 per shared digit, and compare
+ * or look up this code instead of building a Score.
+ */
+constexpr int matchCode(int right, int shared)
+{
+    return right * 5 + shared;
+}
+
+/**
+ * @brief Returns the match code of a score.
+ */
+inline int matchCode(const Score& score)
+{
+    return matchCode(score.right_position, score.right_position + score.wrong_position);
+}
+
+/**
+ * The outcome index of every match code; codes no score has map to
+ * NUM_OUTCOMES. The outcome indices follow the scores in order of right and
+ * then wrong positions.
+ */
+inline constexpr std::array<std::uint8_t, NUM_MATCH_CODES> MATCH_OUTCOMES = []()
+{
+    std::array<std::uint8_t, NUM_MATCH_CODES> outcomes{};
+    outcomes.fill(NUM_OUTCOMES);
+    int outcome = 0;
+    for (int right = 0; right <= 4; right++)
+    {
+        for (int wrong = 0; right + wrong <= 4; wrong++)
+        {
+            if (right != 3 || wrong != 1)
+            {
+                outcomes[matchCode(right, right + wrong)] = static_cast<std::uint8_t>(outcome++);
+            }
+        }
+    }
+    return outcomes;
+}();
+
+/**
+ * @brief Maps a score onto its outcome index.
+ *
+ * The outcome index is a dense number in the range [0, NUM_OUTCOMES) which
+ * can be used to index histograms of scores. The outcome of a correctly
+ * guessed code is `NUM_OUTCOMES - 1`.
+ *
+ * @param score The score to map.
+ * @return The outcome index of the score.
+ */
+int outcomeIndex(const Score& score);
+
+/**
+ * @brief Maps an outcome index back onto its score.
+ *
+ * @param index The outcome index in the range [0, NUM_OUTCOMES).
+ * @return The score with the given outcome index.
+ */
+Score outcomeScore(int index);
+
+/**
+ * @brief Calculate the score for a guess against a secret code.
+ *
+ * @param guess The guessed digit combination.
+ * @param code The secret digit combination.
+ * @return Score The resulting score of the guess.
+ *
+ * The score is calculated based on the number of digits in the correct
+ * position (right position) and the number of digits that are in the code
+ * but in the wrong position (wrong position).
+ *
+ * The function iterates through each digit of the guess and checks if it
+ * is in the correct position or the wrong position.
+ *
+ * If a digit is in the correct position, the `right_position` score is
+ * incremented. If a digit is in the code but not in the correct position,
+ * the `wrong_position` score is incremented and the digit is marked as counted.
+ *
+ * @note The function assumes that both `guess` and `code` are valid digit
+ * combinations of length 4.
+ *
+ * @see Score
+ * @see DigitCombination
+ */
+Score calculateScore(DigitCombination guess, DigitCombination code);
+
+/**
+ * @brief Generates all possible combinations of digits from 0 to level-1.
+ *
+ * This function generates all possible combinations of digits from 0 to level-1
+ * without repetition. Each combination is represented by a DigitCombination,
+ * which is an array of 4 integers.
+ *
+ * @param level The maximum digit value (level-1) for generating combinations.
+ * @return CombinationList A vector of DigitCombinations representing all the
+ * combinations.
+ */
+CombinationList generateAllCombinations(int level);
+
+/**
+ * @brief Checks whether a combination can be played at a level.
+ *
+ * A combination is valid when its 4 digits are distinct and between 0 and
+ * level-1, as those generated by generateAllCombinations().
+ *
+ * @param combination The combination to check.
+ * @param level The difficulty level.
+ * @return True if the combination is one of the level's combinations.
+ */
+bool isValidCombination(const DigitCombination& combination, int level);
+
+/**
+ * @brief Filter combinations based on guess and score.
+ *
+ * This function filters a list of combinations based on a guess and score.
+ * It removes combinations that don't produce the same score as the
+ * guess and score provided. Guesses of four distinct digits below 10 go
+ * through FilterPipeline; any other guess is scored with calculateScore().
+ *
+ * @param allCombinations The list of combinations to filter.
+ * @param guess The guess combination.
+ * @param score The score to compare against.
+ */
+void filterCombinations(CombinationList& allCombinations,
+                        const DigitCombination& guess,
+                        const Score& score);
+
+/**
+ * @brief Selects a random combination from a list of combinations.
+ *
+ * @param combinations The list of combinations to select from.
+ * @return The randomly selected combination.
+ */
+DigitCombination selectRandomCombination(const CombinationList& combinations);
@@ -0,0 +1,11 @@
+#include "filter_pipeline.h"
+
+#include <vector>
+
+void FilterPipeline::filter(CombinationList& candidates)
+{
+    std::erase_if(candidates, [&](const DigitCombination& code)
+    {
+        return !(*this)(code);
+    });
+}
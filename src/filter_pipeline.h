@@ -0,0 +1,101 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "digitmind.h"
+
+/**
+ * @brief Filters candidates by a guess and its score in two stages.
+ *
+ * Most candidates that do not give the score already differ in the number of
+ * digits they share with the guess (right plus wrong positions). The first
+ * stage compares that number, the popcount of the intersection of two digit
+ * masks; only the candidates passing it are scored exactly in the second
+ * stage, which then only has to count the right positions, as the wrong
+ * positions follow from the shared digits.
+ *
+ * The pipeline can be applied to a stream of candidates one at a time or to a
+ * whole list, and counts how many candidates every stage rejected.
+ *
+ * Both stages rely on the guess having four distinct digits below 10, which
+ * supports() tells; other guesses must be filtered with calculateScore().
+ */
+class FilterPipeline
+{
+public:
+    struct Statistics
+    {
+        std::size_t examined = 0;           // Candidates entering the pipeline
+        std::size_t rejectedShared = 0;     // Rejected by the shared-digit count
+        std::size_t rejectedRight = 0;      // Rejected by the right-position count
+    };
+
+    /**
+     * @param guess The guess.
+     * @param score The score the guess received.
+     */
+    FilterPipeline(const DigitCombination& guess, const Score& score)
+        : guess(guess), guessMask(digitMask(guess)), shared(score.right_position + score.wrong_position),
+          right(score.right_position)
+    {
+        assert(supports(guess));
+    }
+
+    /**
+     * @brief Returns whether the pipeline can filter by a guess: its digits
+     * must be distinct and below 10.
+     */
+    static bool supports(const DigitCombination& guess)
+    {
+        for (int digit : guess)
+        {
+            if (digit < 0 || digit >= 10)
+            {
+                return false;
+            }
+        }
+        return std::popcount(digitMask(guess)) == 4;
+    }
+
+    /**
+     * @brief Returns whether a candidate gives the score for the guess.
+     */
+    bool operator()(const DigitCombination& code)
+    {
+        stats.examined++;
+        if (std::popcount(static_cast<unsigned>(digitMask(code) & guessMask)) != shared)
+        {
+            stats.rejectedShared++;
+            return false;
+        }
+        int rightCount = (code[0] == guess[0]) + (code[1] == guess[1]) + (code[2] == guess[2])
+                         + (code[3] == guess[3]);
+        if (rightCount != right)
+        {
+            stats.rejectedRight++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes the candidates that do not give the score, keeping the
+     * order of the others.
+     */
+    void filter(CombinationList& candidates);
+
+    const Statistics& statistics() const
+    {
+        return stats;
+    }
+
+private:
+    DigitCombination guess;
+    unsigned guessMask;
+    int shared;
+    int right;
+    Statistics stats;
+};
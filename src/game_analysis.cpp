@@ -0,0 +1,54 @@
+#include "game_analysis.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "level_cache.h"
+#include "parallel.h"
+
+GameAnalysis analyzeGame(int level, const GameHistory& history)
+{
+    GameAnalysis analysis;
+    CombinationList candidates = levelData(level).combinations;
+    GameHistory played;
+    for (const Move& move : history)
+    {
+        // Only the level's combinations can be evaluated and searched from
+        if (!isValidCombination(move.guess, level))
+        {
+            break;
+        }
+
+        MoveAnalysis moveAnalysis;
+        moveAnalysis.move = move;
+        moveAnalysis.candidatesBefore = candidates.size();
+        moveAnalysis.player = evaluateGuess(move.guess, candidates);
+        // A best guess from the solution stores has its figures rounded to
+        // float, so it is evaluated again to compare it with the player's
+        DigitCombination bestGuess = findBestGuess(Strategy::Entropy, level, played, candidates).guess;
+        moveAnalysis.best = evaluateGuess(bestGuess, candidates);
+        moveAnalysis.regret = std::max(0.0, moveAnalysis.best.entropy - moveAnalysis.player.entropy);
+
+        filterCombinations(candidates, move.guess, move.score);
+        played.push_back(move);
+        if (candidates.empty())
+        {
+            break;
+        }
+        moveAnalysis.candidatesAfter = candidates.size();
+        moveAnalysis.informationGained = std::log2(static_cast<double>(moveAnalysis.candidatesBefore)
+                                                   / static_cast<double>(candidates.size()));
+        analysis.push_back(moveAnalysis);
+    }
+    return analysis;
+}
+
+std::vector<GameAnalysis> analyzeGames(int level, const std::vector<GameHistory>& games)
+{
+    std::vector<GameAnalysis> analyses(games.size());
+    parallelFor(games.size(), [&](std::size_t i)
+    {
+        analyses[i] = analyzeGame(level, games[i]);
+    });
+    return analyses;
+}
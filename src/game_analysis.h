@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * The quality of one move of a game.
+ *
+ * Information is measured in bits: a score that leaves half of the
+ * combinations gains one bit. The best guess is the one with the highest
+ * expected information (the entropy strategy), and the regret of a move is the
+ * expected information the player gave up by not making it.
+ */
+struct MoveAnalysis
+{
+    Move move;
+    std::size_t candidatesBefore;   // Combinations possible before the move
+    std::size_t candidatesAfter;    // Combinations possible after the score
+    double informationGained;       // Bits actually gained by the score
+    GuessEvaluation player;         // Evaluation of the player's guess
+    GuessEvaluation best;           // Evaluation of the best guess
+    double regret;                  // Expected bits of the best guess minus those of the player's guess
+};
+
+typedef std::vector<MoveAnalysis> GameAnalysis;
+
+/**
+ * @brief Analyzes the moves of a recorded game.
+ *
+ * The candidates are followed through the game, and for every move the
+ * player's guess is evaluated against them and compared with the best guess.
+ * The best guesses are found with findBestGuess(), so states that were already
+ * searched (by this or an earlier game, or by the solver) are looked up in the
+ * shared caches instead of being searched again.
+ *
+ * @param level The difficulty level of the game.
+ * @param history The moves of the game, including the winning one.
+ * @return The analysis of every move; it ends early at a guess that is not a
+ * combination of the level (see isValidCombination()) or at a score that no
+ * combination gives.
+ */
+GameAnalysis analyzeGame(int level, const GameHistory& history);
+
+/**
+ * @brief Analyzes many recorded games of a level in parallel.
+ *
+ * @param level The difficulty level of the games.
+ * @param games The moves of every game.
+ * @return The analysis of every game, in the order of `games`.
+ */
+std::vector<GameAnalysis> analyzeGames(int level, const std::vector<GameHistory>& games);
@@ -0,0 +1,110 @@
+#include "inverted_index.h"
+
+#include <array>
+
+namespace
+{
+
+/**
+ * @brief Removes the ids that are not kept from a sorted list.
+ */
+void keepIds(std::vector<std::uint16_t>& list, const std::vector<bool>& keep)
+{
+    std::size_t kept = 0;
+    for (std::uint16_t id : list)
+    {
+        if (keep[id])
+        {
+            list[kept++] = id;
+        }
+    }
+    list.resize(kept);
+}
+
+} // namespace
+
+InvertedIndex::InvertedIndex(const CombinationList& candidates)
+    : codes(candidates)
+{
+    for (std::size_t id = 0; id < codes.size(); id++)
+    {
+        ids.push_back(static_cast<std::uint16_t>(id));
+        for (int position = 0; position < 4; position++)
+        {
+            int digit = codes[id][position];
+            positionPostings[position * 10 + digit].push_back(static_cast<std::uint16_t>(id));
+            digitPostings[digit].push_back(static_cast<std::uint16_t>(id));
+        }
+    }
+}
+
+std::vector<std::uint8_t> InvertedIndex::countMatches(const DigitCombination& guess) const
+{
+    // Sum the match code of each right position and each shared digit
+    std::vector<std::uint8_t> matches(codes.size(), 0);
+    for (int position = 0; position < 4; position++)
+    {
+        for (std::uint16_t id : postings(position, guess[position]))
+        {
+            matches[id] += matchCode(1, 0);
+        }
+        for (std::uint16_t id : postings(guess[position]))
+        {
+            matches[id] += matchCode(0, 1);
+        }
+    }
+    return matches;
+}
+
+OutcomeHistogram InvertedIndex::histogram(const DigitCombination& guess) const
+{
+    std::vector<std::uint8_t> matches = countMatches(guess);
+    std::array<int, NUM_MATCH_CODES> counts{};
+    for (std::uint16_t id : ids)
+    {
+        counts[matches[id]]++;
+    }
+
+    OutcomeHistogram histogram{};
+    for (int count = 0; count < NUM_MATCH_CODES; count++)
+    {
+        if (counts[count] != 0)
+        {
+            histogram[MATCH_OUTCOMES[count]] += counts[count];
+        }
+    }
+    return histogram;
+}
+
+void InvertedIndex::filter(const DigitCombination& guess, const Score& score)
+{
+    std::vector<std::uint8_t> matches = countMatches(guess);
+    int wanted = matchCode(score);
+
+    std::vector<bool> keep(codes.size(), false);
+    for (std::uint16_t id : ids)
+    {
+        keep[id] = matches[id] == wanted;
+    }
+
+    keepIds(ids, keep);
+    for (auto& list : positionPostings)
+    {
+        keepIds(list, keep);
+    }
+    for (auto& list : digitPostings)
+    {
+        keepIds(list, keep);
+    }
+}
+
+CombinationList InvertedIndex::combinations() const
+{
+    CombinationList live;
+    live.reserve(ids.size());
+    for (std::uint16_t id : ids)
+    {
+        live.push_back(codes[id]);
+    }
+    return live;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * @brief A set of candidates indexed by posting lists.
+ *
+ * For every position and digit there is a sorted list of the ids of the
+ * candidates with that digit at that position, and for every digit a list of
+ * the candidates containing it. The right positions of a guess in a candidate
+ * are the number of lists of the guess's (position, digit) pairs the
+ * candidate appears in, and its shared digits the number of lists of the
+ * guess's digits; both are counted by walking the eight lists instead of
+ * scoring every candidate. The lists only hold live candidates: filtering
+ * removes the others from every list, keeping them sorted.
+ */
+class InvertedIndex
+{
+public:
+    /**
+     * @param candidates The candidates to index; their ids are their indices.
+     */
+    explicit InvertedIndex(const CombinationList& candidates);
+
+    /**
+     * @brief Returns the number of live candidates.
+     */
+    std::size_t size() const
+    {
+        return ids.size();
+    }
+
+    /**
+     * @brief Returns the sorted ids of the live candidates with a digit at a position.
+     */
+    const std::vector<std::uint16_t>& postings(int position, int digit) const
+    {
+        return positionPostings[position * 10 + digit];
+    }
+
+    /**
+     * @brief Returns the sorted ids of the live candidates containing a digit.
+     */
+    const std::vector<std::uint16_t>& postings(int digit) const
+    {
+        return digitPostings[digit];
+    }
+
+    /**
+     * @brief Counts the live candidates giving each score for a guess.
+     */
+    OutcomeHistogram histogram(const DigitCombination& guess) const;
+
+    /**
+     * @brief Removes the candidates that do not give the score for the guess.
+     */
+    void filter(const DigitCombination& guess, const Score& score);
+
+    /**
+     * @brief Returns the live candidates in their original order.
+     */
+    CombinationList combinations() const;
+
+private:
+    /**
+     * @brief Computes, for every id, the matchCode() of the right positions
+     * and shared digits of a guess from the posting lists.
+     */
+    std::vector<std::uint8_t> countMatches(const DigitCombination& guess) const;
+
+    CombinationList codes;
+    std::vector<std::uint16_t> ids;
+    std::vector<std::uint16_t> positionPostings[4 * 10];
+    std::vector<std::uint16_t> digitPostings[10];
+};
@@ -0,0 +1,77 @@
+#include "level_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+struct CacheEntry
+{
+    std::once_flag built;
+    std::unique_ptr<LevelData> data;
+};
+
+std::array<CacheEntry, MAX_LEVEL - MIN_LEVEL + 1>& cacheEntries()
+{
+    static std::array<CacheEntry, MAX_LEVEL - MIN_LEVEL + 1> entries;
+    return entries;
+}
+
+} // namespace
+
+LevelData::LevelData(int level)
+    : level(level), view(attachLevelView(level))
+{
+    if (view)
+    {
+        combinations = view->combinations();
+    }
+    else
+    {
+        matrix.emplace(level);
+        combinations = matrix->combinations();
+    }
+}
+
+std::size_t LevelData::indexOf(const DigitCombination& combination) const
+{
+    return std::lower_bound(combinations.begin(), combinations.end(), combination) - combinations.begin();
+}
+
+GameState::GameState(const LevelData& data)
+    : candidates(data.combinations), histograms(data)
+{
+}
+
+const LevelData& levelData(int level)
+{
+    CacheEntry& entry = cacheEntries()[level - MIN_LEVEL];
+    std::call_once(entry.built, [&]()
+    {
+        entry.data = std::make_unique<LevelData>(level);
+    });
+    return *entry.data;
+}
+
+void prewarmLevelData()
+{
+    // The entries are created first, so that they outlive the worker, which
+    // is joined at exit
+    cacheEntries();
+    static std::once_flag started;
+    static std::jthread worker;
+    std::call_once(started, []()
+    {
+        worker = std::jthread([]()
+        {
+            for (int level = MAX_LEVEL; level >= MIN_LEVEL; level--)
+            {
+                levelData(level);
+            }
+        });
+    });
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "digitmind.h"
+#include "level_tables.h"
+#include "partition_histograms.h"
+#include "score_matrix.h"
+
+/**
+ * @brief The immutable data of a level, shared by all games of the process.
+ *
+ * The combinations and scores of every level come from a view into the
+ * tables of level 10 (see attachLevelView()), so the levels of a process
+ * share one mapped set of tables instead of holding a copy each. When the
+ * tables cannot be attached, as in a directory that is not writable, the
+ * level builds a PackedScoreMatrix of its own.
+ */
+struct LevelData
+{
+    explicit LevelData(int level);
+
+    /**
+     * @brief Returns the index of a combination of the level in combinations.
+     */
+    std::size_t indexOf(const DigitCombination& combination) const;
+
+    /**
+     * @brief Returns the outcome index of a guess against a secret.
+     *
+     * @param guess The index of the guess in combinations.
+     * @param secret The index of the secret in combinations.
+     */
+    int outcome(std::size_t guess, std::size_t secret) const
+    {
+        return view ? view->outcome(guess, secret) : matrix->outcome(guess, secret);
+    }
+
+    /**
+     * @brief Returns the column of a combination in the rows of forEachRow().
+     *
+     * @param i The index of the combination in combinations.
+     */
+    std::size_t column(std::size_t i) const
+    {
+        return view ? view->id(i) : i;
+    }
+
+    /**
+     * @brief Calls visit(guess, row) for every guess in generation order, with
+     * row[column(i)] the outcome index of the guess against combination i.
+     *
+     * The rows of the tables are passed directly; the rows of the packed
+     * matrix are unpacked a tile row at a time.
+     */
+    template <typename Visit>
+    void forEachRow(Visit visit) const
+    {
+        if (view)
+        {
+            for (std::size_t g = 0; g < view->size(); g++)
+            {
+                visit(g, view->tables().row(view->id(g)));
+            }
+            return;
+        }
+
+        std::size_t n = matrix->size();
+        std::vector<std::uint8_t> rows(PackedScoreMatrix::TILE_SIZE * n);
+        for (std::size_t tileRow = 0; tileRow < matrix->tileRows(); tileRow++)
+        {
+            matrix->unpackRows(tileRow, rows.data());
+            std::size_t first = tileRow * PackedScoreMatrix::TILE_SIZE;
+            for (std::size_t g = first; g < std::min(first + PackedScoreMatrix::TILE_SIZE, n); g++)
+            {
+                visit(g, &rows[(g - first) * n]);
+            }
+        }
+    }
+
+    int level;
+    std::optional<LevelView> view;              // The scores, when the tables are attached
+    std::optional<PackedScoreMatrix> matrix;    // Otherwise, the scores of this level only
+    CombinationList combinations;               // All combinations in generation order; the
+                                                // guesses of every game of the level
+};
+
+/**
+ * @brief The state of one game, which starts with all combinations of a level.
+ *
+ * The state only holds what changes during the game; the guesses and scores
+ * stay in the level data, which the histograms refer to. The histograms are
+ * empty until a search prepares them, so a game that never needs them, such
+ * as a human guessing, only copies the candidates.
+ */
+struct GameState
+{
+    explicit GameState(const LevelData& data);
+
+    CombinationList candidates;         // Combinations that are still possible
+    PartitionHistograms histograms;     // Kept up to date with the candidates
+    GameHistory history;                // Moves made so far
+};
+
+/**
+ * @brief Returns the data of a level.
+ *
+ * The data is built on first use and kept for the lifetime of the process, so
+ * later games and searches at the same level do not build it again. The
+ * first level built attaches the level-10 tables, publishing them when there
+ * is no valid tables file yet. It is safe to call concurrently; a caller
+ * waits while another builds the level.
+ *
+ * @param level The difficulty level, from 4 to 10.
+ */
+const LevelData& levelData(int level);
+
+/**
+ * @brief Starts building the data of all levels in a background thread.
+ *
+ * Called at startup, the data is ready by the time the user has chosen a
+ * level. Calling it again has no effect.
+ */
+void prewarmLevelData();
@@ -0,0 +1,176 @@
+#include "level_tables.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+#include "score_matrix.h"
+
+namespace
+{
+
+const char MAGIC[8] = "DMTABLE";
+const std::uint32_t FORMAT_VERSION = 1;
+const std::uint64_t SECTION_ALIGNMENT = 64;
+
+std::uint64_t align(std::uint64_t offset)
+{
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+/**
+ * @brief Returns the number of combinations of 4 distinct digits of a level.
+ */
+std::size_t combinationCount(int level)
+{
+    return static_cast<std::size_t>(level) * (level - 1) * (level - 2) * (level - 3);
+}
+
+/**
+ * @brief Returns the header describing the layout of the tables of a level.
+ */
+LevelTablesHeader makeHeader(int level, std::size_t codeCount)
+{
+    LevelTablesHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.level = static_cast<std::uint32_t>(level);
+    header.codeCount = codeCount;
+    header.partitionWords = (codeCount + 63) / 64;
+    header.codesOffset = align(sizeof(LevelTablesHeader));
+    header.scoresOffset = align(header.codesOffset + codeCount * sizeof(DigitCombination));
+    header.partitionsOffset = align(header.scoresOffset + codeCount * codeCount);
+    header.fileSize = header.partitionsOffset
+                      + codeCount * NUM_OUTCOMES * header.partitionWords * sizeof(std::uint64_t);
+    return header;
+}
+
+} // namespace
+
+LevelTables::LevelTables(MappedFile file)
+    : file(std::move(file))
+{
+    auto base = static_cast<const char*>(this->file.data());
+    header = static_cast<const LevelTablesHeader*>(this->file.data());
+    codes = reinterpret_cast<const DigitCombination*>(base + header->codesOffset);
+    scores = reinterpret_cast<const std::uint8_t*>(base + header->scoresOffset);
+    partitions = reinterpret_cast<const std::uint64_t*>(base + header->partitionsOffset);
+}
+
+std::optional<LevelTables> LevelTables::open(const std::string& path, int level)
+{
+    std::optional<MappedFile> file = MappedFile::open(path, sizeof(LevelTablesHeader));
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    // Check that the file holds the tables of this level in the current layout
+    auto header = static_cast<const LevelTablesHeader*>(file->data());
+    LevelTablesHeader expected = makeHeader(level, combinationCount(level));
+    bool valid = std::memcmp(header, &expected, sizeof(LevelTablesHeader)) == 0
+                 && header->fileSize == file->size();
+    if (!valid)
+    {
+        return std::nullopt;
+    }
+
+    return LevelTables(std::move(*file));
+}
+
+LevelView::LevelView(const LevelTables& tables, int level)
+    : base(&tables), viewLevel(level), memberBits(tables.partitionWords(), 0)
+{
+    for (std::size_t id = 0; id < tables.size(); id++)
+    {
+        const DigitCombination& code = tables.combinations()[id];
+        if (*std::max_element(code.begin(), code.end()) < level)
+        {
+            ids.push_back(static_cast<std::uint16_t>(id));
+            memberBits[id / 64] |= std::uint64_t{1} << (id % 64);
+        }
+    }
+}
+
+CombinationList LevelView::combinations() const
+{
+    CombinationList codes;
+    codes.reserve(ids.size());
+    for (std::uint16_t id : ids)
+    {
+        codes.push_back(base->combinations()[id]);
+    }
+    return codes;
+}
+
+bool publishLevelTables(const std::string& path, int level)
+{
+    ScoreMatrix matrix(level);
+    std::size_t n = matrix.size();
+    LevelTablesHeader header = makeHeader(level, n);
+
+    std::vector<std::uint64_t> partitions(n * NUM_OUTCOMES * header.partitionWords);
+    parallelFor(n, [&](std::size_t guess)
+    {
+        std::uint64_t* bitsets = &partitions[guess * NUM_OUTCOMES * header.partitionWords];
+        const std::uint8_t* row = matrix.row(guess);
+        for (std::size_t secret = 0; secret < n; secret++)
+        {
+            bitsets[row[secret] * header.partitionWords + secret / 64] |= std::uint64_t{1} << (secret % 64);
+        }
+    }, 16);
+
+    return writeCacheFile(path, [&](std::ostream& file)
+    {
+        // Writes a section at its offset, padding from the end of the previous one
+        std::uint64_t written = sizeof(header);
+        auto writeSection = [&](std::uint64_t offset, const void* data, std::size_t size)
+        {
+            std::vector<char> padding(offset - written, 0);
+            file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            written = offset + size;
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeSection(header.codesOffset, matrix.combinations().data(), n * sizeof(DigitCombination));
+        writeSection(header.scoresOffset, matrix.row(0), n * n);
+        writeSection(header.partitionsOffset, partitions.data(), partitions.size() * sizeof(std::uint64_t));
+    });
+}
+
+std::string levelTablesPath(int level)
+{
+    return cacheFilePath("digitmind-" + std::to_string(level) + ".tables");
+}
+
+std::optional<LevelTables> attachLevelTables(int level)
+{
+    std::string path = levelTablesPath(level);
+    std::optional<LevelTables> tables = LevelTables::open(path, level);
+    if (!tables && publishLevelTables(path, level))
+    {
+        tables = LevelTables::open(path, level);
+    }
+    return tables;
+}
+
+std::optional<LevelView> attachLevelView(int level)
+{
+    // Every lower level is a view of the highest one
+    static std::optional<LevelTables> tables;
+    static std::once_flag attached;
+    std::call_once(attached, []()
+    {
+        tables = attachLevelTables(MAX_LEVEL);
+    });
+    if (!tables)
+    {
+        return std::nullopt;
+    }
+    return LevelView(*tables, level);
+}
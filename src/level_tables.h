@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cache_file.h"
+#include "digitmind.h"
+
+/**
+ * The header at the start of every level tables file.
+ *
+ * The sections follow the header at the given offsets, each aligned to a
+ * cache line:
+ * - the combinations of the level in generation order;
+ * - the outcome index of every (guess, secret) pair, one byte each, row by row;
+ * - for every guess and outcome, a bitset of the secrets giving that outcome.
+ */
+struct LevelTablesHeader
+{
+    char magic[8];                  // "DMTABLE"
+    std::uint32_t formatVersion;    // Layout of the file
+    std::uint32_t level;
+    std::uint64_t codeCount;
+    std::uint64_t partitionWords;   // Words of 64 bits per partition bitset
+    std::uint64_t codesOffset;
+    std::uint64_t scoresOffset;
+    std::uint64_t partitionsOffset;
+    std::uint64_t fileSize;
+};
+
+/**
+ * @brief The read-only tables of a level, shared by all processes through a
+ * memory-mapped file.
+ *
+ * Building the tables of level 10 takes a noticeable time and about 70 MB.
+ * Instead of every process building its own copy, the first process publishes
+ * them into a file and every process maps that file read-only, so the pages
+ * are shared and a further process starts with a single mmap call. The header
+ * records the layout version and the level; a file that does not match is
+ * rejected when it is opened and rebuilt by attachLevelTables().
+ */
+class LevelTables
+{
+public:
+    /**
+     * @brief Maps a level tables file.
+     *
+     * @param path The path of the file.
+     * @param level The level the tables must be for.
+     * @return The tables, or nothing when the file does not exist or does not
+     * match the level or the current layout.
+     */
+    static std::optional<LevelTables> open(const std::string& path, int level);
+
+    int level() const
+    {
+        return static_cast<int>(header->level);
+    }
+
+    /**
+     * @brief Returns the number of combinations of the level.
+     */
+    std::size_t size() const
+    {
+        return header->codeCount;
+    }
+
+    /**
+     * @brief Returns the combinations of the level in generation order.
+     */
+    const DigitCombination* combinations() const
+    {
+        return codes;
+    }
+
+    /**
+     * @brief Returns the outcome index of a guess against a secret.
+     *
+     * @param guess The index of the guess in generation order.
+     * @param secret The index of the secret in generation order.
+     */
+    int outcome(std::size_t guess, std::size_t secret) const
+    {
+        return scores[guess * header->codeCount + secret];
+    }
+
+    /**
+     * @brief Returns the outcome indices of a guess against every secret.
+     */
+    const std::uint8_t* row(std::size_t guess) const
+    {
+        return &scores[guess * header->codeCount];
+    }
+
+    /**
+     * @brief Returns the bitset of the secrets giving an outcome for a guess.
+     *
+     * Bit i of the bitset, of partitionWords() words, is set when secret i
+     * gives the outcome.
+     */
+    const std::uint64_t* partition(std::size_t guess, int outcome) const
+    {
+        return &partitions[(guess * NUM_OUTCOMES + outcome) * header->partitionWords];
+    }
+
+    std::size_t partitionWords() const
+    {
+        return header->partitionWords;
+    }
+
+    /**
+     * @brief Returns the size of the mapped file in bytes.
+     */
+    std::size_t bytes() const
+    {
+        return file.size();
+    }
+
+private:
+    explicit LevelTables(MappedFile file);
+
+    MappedFile file;
+    const LevelTablesHeader* header;
+    const DigitCombination* codes;
+    const std::uint8_t* scores;
+    const std::uint64_t* partitions;
+};
+
+/**
+ * @brief The tables of a lower level as a view into the tables of a higher level.
+ *
+ * Every combination of a level is also a combination of every higher level
+ * and gets the same scores, and generating the combinations in lexicographic
+ * order keeps the combinations of the lower level in the same relative order.
+ * A view therefore only holds the ids (indices in generation order) of its
+ * combinations in the higher level, and answers every lookup from the tables
+ * of that level. A process supporting all levels maps the tables of level 10
+ * once and uses views for the other levels.
+ *
+ * Combinations of the view are identified by their index in the view, but
+ * rows and partition bitsets of the underlying tables are indexed by the ids
+ * of the higher level; members() selects the combinations of the view in them.
+ */
+class LevelView
+{
+public:
+    /**
+     * @param tables The tables of a level at least as high as the view's.
+     * @param level The level of the view.
+     */
+    LevelView(const LevelTables& tables, int level);
+
+    int level() const
+    {
+        return viewLevel;
+    }
+
+    /**
+     * @brief Returns the number of combinations of the level.
+     */
+    std::size_t size() const
+    {
+        return ids.size();
+    }
+
+    /**
+     * @brief Returns combination i of the level in generation order.
+     */
+    const DigitCombination& combination(std::size_t i) const
+    {
+        return base->combinations()[ids[i]];
+    }
+
+    /**
+     * @brief Returns all combinations of the level in generation order.
+     */
+    CombinationList combinations() const;
+
+    /**
+     * @brief Returns the id of combination i in the underlying tables.
+     */
+    std::size_t id(std::size_t i) const
+    {
+        return ids[i];
+    }
+
+    /**
+     * @brief Returns the outcome index of a guess against a secret.
+     *
+     * @param guess The index of the guess in the view.
+     * @param secret The index of the secret in the view.
+     */
+    int outcome(std::size_t guess, std::size_t secret) const
+    {
+        return base->outcome(ids[guess], ids[secret]);
+    }
+
+    /**
+     * @brief Returns the bitset over the ids of the underlying tables that has
+     * the bits of the combinations of the view set.
+     */
+    const std::vector<std::uint64_t>& members() const
+    {
+        return memberBits;
+    }
+
+    const LevelTables& tables() const
+    {
+        return *base;
+    }
+
+private:
+    const LevelTables* base;
+    int viewLevel;
+    std::vector<std::uint16_t> ids;
+    std::vector<std::uint64_t> memberBits;
+};
+
+/**
+ * @brief Builds the tables of a level and writes them to a file.
+ *
+ * The file is written with writeCacheFile(), so that a process never maps a
+ * partially written file.
+ *
+ * @param path The path of the file.
+ * @param level The difficulty level of the game.
+ * @return Whether the file was written.
+ */
+bool publishLevelTables(const std::string& path, int level);
+
+/**
+ * @brief Returns the path of the tables file of a level.
+ *
+ * The files are located with cacheFilePath().
+ */
+std::string levelTablesPath(int level);
+
+/**
+ * @brief Maps the tables of a level, publishing them first when there is no
+ * valid tables file yet.
+ *
+ * @param level The difficulty level of the game.
+ * @return The tables, or nothing when the file could not be written or mapped.
+ */
+std::optional<LevelTables> attachLevelTables(int level);
+
+/**
+ * @brief Returns the tables of a level as a view into the tables of level 10.
+ *
+ * The tables of level 10 are attached on first use and stay mapped for the
+ * lifetime of the process, so a process using several levels maps (and, when
+ * missing, publishes) a single file. It is safe to call concurrently.
+ *
+ * @param level The difficulty level, from 4 to 10.
+ * @return The view, or nothing when the tables could not be attached.
+ */
+std::optional<LevelView> attachLevelView(int level);
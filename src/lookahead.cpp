@@ -0,0 +1,169 @@
+#include "lookahead.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "candidate_set.h"
+#include "level_cache.h"
+#include "outcome_partition.h"
+#include "parallel.h"
+#include "transposition_table.h"
+
+namespace
+{
+
+/**
+ * @brief The buckets already searched for their best follow-up guess.
+ */
+class BucketMemo
+{
+public:
+    std::optional<double> find(const CandidateSetKey& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = values.find(key);
+        if (it == values.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void insert(const CandidateSetKey& key, double value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        values.emplace(key, value);
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<CandidateSetKey, double> values;
+};
+
+/**
+ * @brief Returns the smallest expected number of combinations remaining after
+ * one more guess in a bucket.
+ *
+ * The expected number is the sum of the squared sizes of the non-winning
+ * buckets divided by the bucket size. A guess is abandoned as soon as its
+ * partial sum exceeds the best sum so far.
+ */
+double bestFollowUp(const LevelData& data, CombinationSpan bucket)
+{
+    // Guessing one of one or two combinations is optimal
+    if (bucket.size() <= 2)
+    {
+        return bucket.size() == 1 ? 0.0 : 0.5;
+    }
+
+    // The scores are looked up in the tables of the level by index
+    std::vector<std::size_t> secrets;
+    secrets.reserve(bucket.size());
+    for (const DigitCombination& code : bucket)
+    {
+        secrets.push_back(data.indexOf(code));
+    }
+
+    long long best = std::numeric_limits<long long>::max();
+    for (std::size_t g : selectDistinctGuesses(data.level, data.combinations, bucket))
+    {
+        OutcomeHistogram histogram{};
+        long long sumOfSquares = 0;
+        for (std::size_t secret : secrets)
+        {
+            int outcome = data.outcome(g, secret);
+            if (outcome != NUM_OUTCOMES - 1)
+            {
+                sumOfSquares += 2 * histogram[outcome] + 1;
+                if (sumOfSquares >= best)
+                {
+                    break;
+                }
+            }
+            histogram[outcome]++;
+        }
+        best = std::min(best, sumOfSquares);
+    }
+    return static_cast<double>(best) / bucket.size();
+}
+
+} // namespace
+
+GuessEvaluation searchLookahead(int level, const CombinationList& candidates, const LookaheadOptions& options)
+{
+    auto deadline = std::chrono::steady_clock::now() + options.budget;
+
+    // With one or two combinations left, guessing one of them is optimal
+    if (candidates.size() <= 2)
+    {
+        return evaluateGuess(candidates.front(), candidates);
+    }
+
+    // Rank the distinct guesses for one step
+    const LevelData& data = levelData(level);
+    const CombinationList& guesses = data.combinations;
+    CandidateSet candidateSet(candidates);
+    std::vector<GuessEvaluation> ranking;
+    for (std::size_t g : selectDistinctGuesses(level, guesses, candidates))
+    {
+        ranking.push_back(evaluateHistogram(guesses[g], candidateSet.histogram(guesses[g])));
+    }
+    std::size_t breadth = std::max<std::size_t>(1, std::min(options.breadth, ranking.size()));
+    std::stable_sort(ranking.begin(), ranking.end(), [](const GuessEvaluation& a, const GuessEvaluation& b)
+    {
+        return isBetterGuess(Strategy::Lookahead, a, b);
+    });
+    ranking.resize(breadth);
+
+    // Look ahead from the best first guesses in parallel, or serially when
+    // the search itself runs on a worker of the solver or analyzer
+    BucketMemo memo;
+    std::vector<std::optional<double>> values(breadth);
+    parallelFor(breadth, [&](std::size_t i)
+    {
+        OutcomePartition partition(ranking[i].guess, candidates);
+
+        double value = 0.0;
+        for (int outcome = 0; outcome < NUM_OUTCOMES - 1; outcome++)
+        {
+            CombinationSpan bucket = partition.bucket(outcome);
+            if (bucket.empty())
+            {
+                continue;
+            }
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return;
+            }
+
+            CandidateSetKey key = hashCandidateSet(bucket);
+            std::optional<double> followUp = memo.find(key);
+            if (!followUp)
+            {
+                followUp = bestFollowUp(data, bucket);
+                memo.insert(key, *followUp);
+            }
+            value += bucket.size() * *followUp / candidates.size();
+        }
+        values[i] = value;
+    });
+
+    // Select the best finished lookahead, keeping the first ranking for ties
+    std::size_t best = 0;
+    bool complete = true;
+    const double epsilon = 1e-9;
+    for (std::size_t i = 0; i < breadth; i++)
+    {
+        if (values[i] && (!values[best] || *values[i] < *values[best] - epsilon))
+        {
+            best = i;
+        }
+        complete = complete && values[i].has_value();
+    }
+    ranking[best].isComplete = complete;
+    return ranking[best];
+}
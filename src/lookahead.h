@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * Settings of the two-step lookahead search.
+ */
+struct LookaheadOptions
+{
+    std::size_t breadth = 8;                        // Number of first guesses looked ahead from
+    std::chrono::milliseconds budget{1000};         // Time after which no new work is started
+};
+
+/**
+ * @brief Searches for the guess with the best expected outcome two guesses ahead.
+ *
+ * The guesses are ranked by the expected number of remaining combinations
+ * after one guess. For the best `breadth` of them, every score bucket is
+ * searched for the follow-up guess that leaves the fewest combinations on
+ * average, and the guess with the smallest expected number of combinations
+ * remaining after both guesses is selected.
+ *
+ * The first guesses are looked ahead from in parallel, unless the search
+ * runs on a worker of a parallelFor() already. Buckets are memoized, since
+ * different first guesses often leave the same candidates. A guess whose
+ * lookahead was not finished within the time budget is not considered; when
+ * no lookahead finishes, the best guess of the first ranking is used. A
+ * result with an unfinished lookahead is not complete (see
+ * GuessEvaluation::isComplete) and is neither cached nor stored.
+ *
+ * @param level The difficulty level of the game.
+ * @param candidates The combinations that are still possible, in generation
+ * order; not empty.
+ * @param options The settings of the search.
+ * @return The evaluation of the selected guess for one step.
+ */
+GuessEvaluation searchLookahead(int level, const CombinationList& candidates,
+                                const LookaheadOptions& options = LookaheadOptions());
@@ -0,0 +1,38 @@
+#include "outcome_partition.h"
+
+#include <algorithm>
+
+OutcomePartition::OutcomePartition(const DigitCombination& guess, CombinationSpan candidates)
+    : codes(candidates.size()), offsets{}
+{
+    // Counting pass, keeping the outcome of every candidate for the scatter
+    std::vector<std::uint8_t> outcomes(candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        outcomes[i] = static_cast<std::uint8_t>(outcomeIndex(calculateScore(guess, candidates[i])));
+        offsets[outcomes[i] + 1]++;
+    }
+
+    for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+    {
+        offsets[outcome + 1] += offsets[outcome];
+    }
+
+    // Scatter pass
+    std::array<std::size_t, NUM_OUTCOMES> next;
+    std::copy(offsets.begin(), offsets.end() - 1, next.begin());
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        codes[next[outcomes[i]]++] = candidates[i];
+    }
+}
+
+OutcomeHistogram OutcomePartition::histogram() const
+{
+    OutcomeHistogram histogram;
+    for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+    {
+        histogram[outcome] = static_cast<int>(offsets[outcome + 1] - offsets[outcome]);
+    }
+    return histogram;
+}
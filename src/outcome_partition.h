@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * @brief The candidates grouped by the score they give for a guess.
+ *
+ * filterCombinations() keeps the bucket of one score and discards the others,
+ * but a search descends into every bucket. The partition computes all buckets
+ * in one step like a radix sort pass: a counting pass scores every candidate
+ * once and counts the candidates per outcome, the prefix sums of the counts
+ * give the offset of every bucket, and a scatter pass copies every candidate
+ * into its bucket in one contiguous buffer. Within a bucket the candidates
+ * keep their order, so every bucket is in generation order like a filtered
+ * list.
+ */
+class OutcomePartition
+{
+public:
+    /**
+     * @param guess The guess to partition by.
+     * @param candidates The candidates to partition.
+     */
+    OutcomePartition(const DigitCombination& guess, CombinationSpan candidates);
+
+    /**
+     * @brief Returns the candidates giving an outcome.
+     *
+     * @param outcome The outcome index.
+     */
+    CombinationSpan bucket(int outcome) const
+    {
+        return CombinationSpan(codes.data() + offsets[outcome], offsets[outcome + 1] - offsets[outcome]);
+    }
+
+    /**
+     * @brief Returns the number of candidates giving each outcome.
+     */
+    OutcomeHistogram histogram() const;
+
+private:
+    CombinationList codes;
+    std::array<std::size_t, NUM_OUTCOMES + 1> offsets;
+};
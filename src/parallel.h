@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns the number of worker threads to use for parallel work.
+ *
+ * @return The hardware concurrency, or 1 when it cannot be determined.
+ */
+inline unsigned workerCount()
+{
+    unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+/**
+ * @brief Returns the flag telling whether the calling thread is running the
+ * indices of a parallelFor().
+ */
+inline bool& isParallelWorker()
+{
+    thread_local bool worker = false;
+    return worker;
+}
+
+/**
+ * @brief Calls a function for every index in [0, count) using all workers.
+ *
+ * Indices are handed out in chunks from a shared counter, so uneven work per
+ * index (e.g. rows of a triangle) is still balanced over the threads. The
+ * function must be safe to call concurrently for different indices. A
+ * parallelFor() called by the function runs serially on its worker, since
+ * all workers are busy already.
+ *
+ * @param count The number of indices.
+ * @param function The function to call with each index.
+ * @param chunk The number of consecutive indices a worker claims at once.
+ */
+template <typename Function>
+void parallelFor(std::size_t count, Function function, std::size_t chunk = 1)
+{
+    unsigned threads = std::min<std::size_t>(workerCount(), (count + chunk - 1) / chunk);
+    if (threads <= 1 || isParallelWorker())
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            function(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]()
+    {
+        isParallelWorker() = true;
+        for (std::size_t begin = next.fetch_add(chunk); begin < count; begin = next.fetch_add(chunk))
+        {
+            std::size_t end = std::min(begin + chunk, count);
+            for (std::size_t i = begin; i < end; i++)
+            {
+                function(i);
+            }
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    for (unsigned t = 1; t < threads; t++)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    isParallelWorker() = false;
+}
@@ -0,0 +1,134 @@
+#include "partition_histograms.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "level_cache.h"
+
+PartitionHistograms::PartitionHistograms(const LevelData& data)
+    : data(&data), total(0), prepared(false)
+{
+}
+
+const CombinationList& PartitionHistograms::guesses() const
+{
+    return data->combinations;
+}
+
+void PartitionHistograms::prepare(const CombinationList& candidates)
+{
+    if (prepared)
+    {
+        return;
+    }
+
+    counts.assign(guesses().size() * NUM_OUTCOMES, 0);
+    total = 0;
+    live.emplace(candidates);
+    count(candidates, 1);
+    stats.built += candidates.size();
+    prepared = true;
+}
+
+void PartitionHistograms::filter(CombinationList& candidates, const DigitCombination& guess,
+                                 const Score& score)
+{
+    if (!prepared)
+    {
+        filterCombinations(candidates, guess, score);
+        return;
+    }
+
+    // Filter the kept set once; the survivors and the removed candidates
+    // both follow from it, in generation order
+    live->filter(guess, score);
+    CombinationList survivors = live->combinations();
+    std::size_t removedCount = candidates.size() - survivors.size();
+    if (removedCount <= survivors.size())
+    {
+        CombinationList removed;
+        removed.reserve(removedCount);
+        std::set_difference(candidates.begin(), candidates.end(), survivors.begin(), survivors.end(),
+                            std::back_inserter(removed));
+        count(removed, -1);
+        stats.subtracted += removed.size();
+    }
+    else
+    {
+        counts.assign(counts.size(), 0);
+        total = 0;
+        count(*live, 1);
+        stats.recounted += survivors.size();
+    }
+
+    candidates.swap(survivors);
+}
+
+OutcomeHistogram PartitionHistograms::histogram(std::size_t guess) const
+{
+    OutcomeHistogram histogram;
+    const std::uint16_t* row = &counts[guess * NUM_OUTCOMES];
+    for (int i = 0; i < NUM_OUTCOMES; i++)
+    {
+        histogram[i] = row[i];
+    }
+    return histogram;
+}
+
+void PartitionHistograms::count(const CandidateSet& codes, int sign)
+{
+    const CombinationList& allGuesses = guesses();
+    for (std::size_t g = 0; g < allGuesses.size(); g++)
+    {
+        std::uint16_t* row = &counts[g * NUM_OUTCOMES];
+        OutcomeHistogram histogram = codes.histogram(allGuesses[g]);
+        for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+        {
+            row[outcome] += sign * histogram[outcome];
+        }
+    }
+    total += sign * static_cast<std::ptrdiff_t>(codes.size());
+}
+
+void PartitionHistograms::count(const CombinationList& codes, int sign)
+{
+    // Look the scores up in the rows of the level by the columns of the codes
+    std::vector<std::size_t> columns;
+    columns.reserve(codes.size());
+    for (const DigitCombination& code : codes)
+    {
+        columns.push_back(data->column(data->indexOf(code)));
+    }
+
+    data->forEachRow([&](std::size_t g, const std::uint8_t* outcomes)
+    {
+        std::uint16_t* row = &counts[g * NUM_OUTCOMES];
+        for (std::size_t column : columns)
+        {
+            row[outcomes[column]] += sign;
+        }
+    });
+    total += sign * static_cast<std::ptrdiff_t>(codes.size());
+}
+
+GuessEvaluation searchBestGuess(Strategy strategy, const PartitionHistograms& histograms,
+                                const CombinationList& candidates)
+{
+    // With one or two combinations left, guessing one of them is optimal
+    if (candidates.size() <= 2)
+    {
+        return evaluateGuess(candidates.front(), candidates);
+    }
+
+    const CombinationList& guesses = histograms.guesses();
+    GuessEvaluation best;
+    for (std::size_t g = 0; g < guesses.size(); g++)
+    {
+        GuessEvaluation evaluation = evaluateHistogram(guesses[g], histograms.histogram(g));
+        if (g == 0 || isBetterGuess(strategy, evaluation, best))
+        {
+            best = evaluation;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "candidate_set.h"
+#include "digitmind.h"
+#include "strategy.h"
+
+struct LevelData;
+
+/**
+ * @brief The score histograms of every guess of a level over the candidates,
+ * maintained across the moves of a game.
+ *
+ * A guess search needs, for every possible guess, the number of candidates
+ * giving each score. Instead of recounting these after every move, the
+ * histograms are updated when the candidates are filtered: the contribution
+ * of the removed candidates is subtracted, or, when fewer candidates survive
+ * than were removed (as after the first moves), the histograms are recounted
+ * from the survivors. The cheaper of both is chosen at every move. Building
+ * and subtracting look the scores up in the rows of the level (see
+ * LevelData::forEachRow()) instead of scoring pairs of combinations.
+ *
+ * The histograms are built lazily by prepare(), so a game whose guesses all
+ * come from the caches never pays for them. Until then filter() only filters.
+ *
+ * Once prepared, the candidates are also kept in a CandidateSet that is
+ * filtered at every move, so it changes representation as the game narrows
+ * the candidates down, and recounting scores the few survivors from it.
+ */
+class PartitionHistograms
+{
+public:
+    struct Statistics
+    {
+        std::size_t built = 0;          // Candidates counted when building
+        std::size_t subtracted = 0;     // Removed candidates subtracted
+        std::size_t recounted = 0;      // Surviving candidates recounted
+    };
+
+    /**
+     * @param data The data of the level; all its combinations are guesses.
+     * It must outlive the histograms.
+     */
+    explicit PartitionHistograms(const LevelData& data);
+
+    /**
+     * @brief Builds the histograms for the candidates, if not done yet.
+     *
+     * @param candidates The combinations that are still possible.
+     */
+    void prepare(const CombinationList& candidates);
+
+    /**
+     * @brief Returns whether the histograms have been built.
+     */
+    bool isPrepared() const { return prepared; }
+
+    /**
+     * @brief Filters the candidates like filterCombinations() and updates the
+     * histograms accordingly.
+     *
+     * @param candidates The candidates; must be the candidates the histograms
+     * were built for and have been filtered with so far.
+     * @param guess The guess combination.
+     * @param score The score of the guess.
+     */
+    void filter(CombinationList& candidates, const DigitCombination& guess, const Score& score);
+
+    /**
+     * @brief Returns all guesses of the level, in generation order.
+     */
+    const CombinationList& guesses() const;
+
+    /**
+     * @brief Returns the histogram of a guess.
+     *
+     * @param guess The index of the guess in guesses().
+     */
+    OutcomeHistogram histogram(std::size_t guess) const;
+
+    /**
+     * @brief Returns the number of candidates the histograms count.
+     */
+    std::size_t candidateCount() const { return total; }
+
+    /**
+     * @brief Returns the candidates kept with the histograms; only valid once
+     * they have been prepared.
+     */
+    const CandidateSet& candidateSet() const { return *live; }
+
+    const Statistics& statistics() const { return stats; }
+
+private:
+    void count(const CandidateSet& codes, int sign);
+    void count(const CombinationList& codes, int sign);     // From the rows of the level
+
+    const LevelData* data;
+    std::optional<CandidateSet> live;   // The candidates, once prepared
+    std::vector<std::uint16_t> counts;   // NUM_OUTCOMES counts per guess
+    std::size_t total;
+    bool prepared;
+    Statistics stats;
+};
+
+/**
+ * @brief Searches the guesses of the histograms for the best next guess.
+ *
+ * This gives the same evaluation as searchBestGuess() for the candidates the
+ * histograms were prepared and filtered with, without scoring any candidate.
+ *
+ * @param strategy The strategy to use; must not be Strategy::Random.
+ * @param histograms The prepared histograms.
+ * @param candidates The combinations that are still possible; not empty.
+ * @return The evaluation of the best guess.
+ */
+GuessEvaluation searchBestGuess(Strategy strategy, const PartitionHistograms& histograms,
+                                const CombinationList& candidates);
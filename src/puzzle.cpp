@@ -0,0 +1,129 @@
+#include "puzzle.h"
+
+#include <algorithm>
+#include <bit>
+
+PuzzleGenerator::PuzzleGenerator(const LevelView& view, const PuzzleOptions& options)
+    : view(&view), tables(&view.tables()), options(options)
+{
+}
+
+std::optional<Puzzle> PuzzleGenerator::generate(std::mt19937& gen) const
+{
+    std::uniform_int_distribution<std::size_t> pick(0, view->size() - 1);
+    for (int i = 0; i < options.maxAttempts; i++)
+    {
+        std::size_t solution = view->id(pick(gen));
+        std::optional<std::vector<Clue>> clues = attempt(solution, gen);
+        if (!clues)
+        {
+            continue;
+        }
+
+        Puzzle puzzle;
+        puzzle.solution = tables->combinations()[solution];
+        for (const Clue& clue : *clues)
+        {
+            puzzle.clues.push_back(Move{tables->combinations()[clue.guess], outcomeScore(clue.outcome)});
+        }
+        return puzzle;
+    }
+    return std::nullopt;
+}
+
+std::size_t PuzzleGenerator::countSolutions(const GameHistory& clues) const
+{
+    const DigitCombination* begin = tables->combinations();
+    const DigitCombination* end = begin + tables->size();
+
+    std::vector<Clue> ids;
+    for (const Move& move : clues)
+    {
+        std::size_t guess = std::lower_bound(begin, end, move.guess) - begin;
+        ids.push_back(Clue{guess, outcomeIndex(move.score)});
+    }
+    return countConsistent(ids, ids.size());
+}
+
+std::optional<std::vector<PuzzleGenerator::Clue>> PuzzleGenerator::attempt(std::size_t solution,
+                                                                             std::mt19937& gen) const
+{
+    std::size_t words = tables->partitionWords();
+    std::vector<std::uint64_t> live = view->members();
+    std::size_t remaining = view->size();
+    std::uniform_int_distribution<std::size_t> pick(0, view->size() - 1);
+
+    // Add random clues that exclude something until the solution is unique;
+    // the clues are minimized below, so allow some more than the maximum
+    std::vector<Clue> clues;
+    for (int draws = 0; remaining > 1 && clues.size() < 2 * options.maxClues && draws < 64; draws++)
+    {
+        std::size_t guess = view->id(pick(gen));
+        int outcome = tables->outcome(guess, solution);
+        if (guess == solution || outcomeScore(outcome).right_position > options.maxRightPosition)
+        {
+            continue;
+        }
+
+        const std::uint64_t* partition = tables->partition(guess, outcome);
+        std::size_t count = 0;
+        for (std::size_t word = 0; word < words; word++)
+        {
+            count += std::popcount(live[word] & partition[word]);
+        }
+        if (count == remaining)
+        {
+            continue;
+        }
+
+        for (std::size_t word = 0; word < words; word++)
+        {
+            live[word] &= partition[word];
+        }
+        remaining = count;
+        clues.push_back(Clue{guess, outcome});
+        draws = 0;
+    }
+    if (remaining > 1)
+    {
+        return std::nullopt;
+    }
+
+    // Remove every clue that the others make superfluous, in random order
+    std::shuffle(clues.begin(), clues.end(), gen);
+    for (std::size_t i = clues.size(); i-- > 0;)
+    {
+        if (countConsistent(clues, i) == 1)
+        {
+            clues.erase(clues.begin() + i);
+        }
+    }
+    if (clues.size() < options.minClues || clues.size() > options.maxClues)
+    {
+        return std::nullopt;
+    }
+    return clues;
+}
+
+std::size_t PuzzleGenerator::countConsistent(const std::vector<Clue>& clues, std::size_t skipped) const
+{
+    if (clues.size() == (skipped < clues.size() ? 1 : 0))
+    {
+        return view->size();
+    }
+
+    std::size_t count = 0;
+    for (std::size_t word = 0; word < tables->partitionWords(); word++)
+    {
+        std::uint64_t bits = view->members()[word];
+        for (std::size_t i = 0; i < clues.size(); i++)
+        {
+            if (i != skipped)
+            {
+                bits &= tables->partition(clues[i].guess, clues[i].outcome)[word];
+            }
+        }
+        count += std::popcount(bits);
+    }
+    return count;
+}
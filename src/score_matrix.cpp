@@ -0,0 +1,167 @@
+#include "score_matrix.h"
+
+#include <algorithm>
+
+#include "parallel.h"
+
+PairScorer::PairScorer(const CombinationList& codes)
+    : packed(codes.size()), masks(codes.size())
+{
+    for (std::size_t i = 0; i < codes.size(); i++)
+    {
+        for (int position = 0; position < 4; position++)
+        {
+            packed[i] |= static_cast<std::uint32_t>(codes[i][position]) << (8 * position);
+        }
+        masks[i] = static_cast<std::uint16_t>(digitMask(codes[i]));
+    }
+}
+
+ScoreMatrix::ScoreMatrix(int level)
+    : codes(generateAllCombinations(level))
+{
+    std::size_t n = codes.size();
+    cells.resize(n * n);
+
+    PairScorer scorer(codes);
+    std::size_t blocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    parallelFor(blocks, [&](std::size_t rowBlock)
+    {
+        std::size_t rowBegin = rowBlock * BLOCK_SIZE;
+        std::size_t rowEnd = std::min(rowBegin + BLOCK_SIZE, n);
+        for (std::size_t columnBlock = rowBlock; columnBlock < blocks; columnBlock++)
+        {
+            std::size_t columnBegin = columnBlock * BLOCK_SIZE;
+            std::size_t columnEnd = std::min(columnBegin + BLOCK_SIZE, n);
+            for (std::size_t i = rowBegin; i < rowEnd; i++)
+            {
+                for (std::size_t j = std::max(columnBegin, i); j < columnEnd; j++)
+                {
+                    std::uint8_t outcome = scorer.outcome(i, j);
+                    cells[i * n + j] = outcome;
+                    cells[j * n + i] = outcome;
+                }
+            }
+        }
+    });
+}
+
+PackedScoreMatrix::PackedScoreMatrix(int level)
+    : codes(generateAllCombinations(level))
+{
+    std::size_t n = codes.size();
+    std::size_t tiles = (n + TILE_SIZE - 1) / TILE_SIZE;
+    tileRowOffsets.resize(tiles);
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < tiles; i++)
+    {
+        tileRowOffsets[i] = offset;
+        offset += (tiles - i) * TILE_BYTES;
+    }
+    nibbles.resize(offset);
+
+    // Offset every row as if its tile row started at tile column 0, so that a
+    // lookup finds the tile of a column from the column alone
+    rowOffsets.resize(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        rowOffsets[i] = tileRowOffsets[i / TILE_SIZE] - i / TILE_SIZE * TILE_BYTES + i % TILE_SIZE * (TILE_SIZE / 2);
+    }
+
+    // Tile rows do not share bytes, so every tile row is written by one worker
+    PairScorer scorer(codes);
+    parallelFor(tiles, [&](std::size_t tileRow)
+    {
+        std::size_t rowEnd = std::min((tileRow + 1) * TILE_SIZE, n);
+        for (std::size_t tileColumn = tileRow; tileColumn < tiles; tileColumn++)
+        {
+            std::uint8_t* entries = &nibbles[tileRowOffsets[tileRow] + (tileColumn - tileRow) * TILE_BYTES];
+            std::size_t columnEnd = std::min((tileColumn + 1) * TILE_SIZE, n);
+            for (std::size_t i = tileRow * TILE_SIZE; i < rowEnd; i++)
+            {
+                for (std::size_t j = tileColumn * TILE_SIZE; j < columnEnd; j++)
+                {
+                    std::size_t column = j % TILE_SIZE;
+                    entries[i % TILE_SIZE * (TILE_SIZE / 2) + column / 2] |= scorer.outcome(i, j) << (column % 2 * 4);
+                }
+            }
+        }
+    });
+}
+
+void PackedScoreMatrix::unpackRow(std::size_t guess, std::uint8_t* row) const
+{
+    std::size_t n = size();
+    std::size_t tileRow = guess / TILE_SIZE;
+    std::size_t r = guess % TILE_SIZE;
+
+    // Left of the diagonal tile, the entries are a column of the tiles above it
+    for (std::size_t tileColumn = 0; tileColumn < tileRow; tileColumn++)
+    {
+        const std::uint8_t* entries = tile(tileColumn, tileRow);
+        std::uint8_t* out = row + tileColumn * TILE_SIZE;
+        for (std::size_t c = 0; c < TILE_SIZE; c++)
+        {
+            out[c] = (entries[c * (TILE_SIZE / 2) + r / 2] >> (r % 2 * 4)) & 0xf;
+        }
+    }
+
+    // From the diagonal tile on, the entries are a row of every tile
+    for (std::size_t tileColumn = tileRow; tileColumn < tileRows(); tileColumn++)
+    {
+        const std::uint8_t* entries = tile(tileRow, tileColumn) + r * (TILE_SIZE / 2);
+        std::uint8_t* out = row + tileColumn * TILE_SIZE;
+        std::size_t count = std::min(TILE_SIZE, n - tileColumn * TILE_SIZE);
+        for (std::size_t c = 0; c < count; c++)
+        {
+            out[c] = (entries[c / 2] >> (c % 2 * 4)) & 0xf;
+        }
+    }
+}
+
+void PackedScoreMatrix::unpackRows(std::size_t tileRow, std::uint8_t* rows) const
+{
+    std::size_t n = size();
+    std::size_t rowCount = std::min(TILE_SIZE, n - tileRow * TILE_SIZE);
+
+    // Left of the diagonal tile, every tile above is written transposed
+    for (std::size_t tileColumn = 0; tileColumn < tileRow; tileColumn++)
+    {
+        const std::uint8_t* entries = tile(tileColumn, tileRow);
+        std::uint8_t* out = rows + tileColumn * TILE_SIZE;
+        for (std::size_t c = 0; c < TILE_SIZE; c++)
+        {
+            for (std::size_t byte = 0; byte < rowCount / 2; byte++)
+            {
+                std::uint8_t pair = entries[c * (TILE_SIZE / 2) + byte];
+                out[2 * byte * n + c] = pair & 0xf;
+                out[(2 * byte + 1) * n + c] = pair >> 4;
+            }
+            if (rowCount % 2 != 0)
+            {
+                out[(rowCount - 1) * n + c] = entries[c * (TILE_SIZE / 2) + rowCount / 2] & 0xf;
+            }
+        }
+    }
+
+    // From the diagonal tile on, the rows of every tile are written as they are
+    for (std::size_t tileColumn = tileRow; tileColumn < tileRows(); tileColumn++)
+    {
+        const std::uint8_t* entries = tile(tileRow, tileColumn);
+        std::size_t count = std::min(TILE_SIZE, n - tileColumn * TILE_SIZE);
+        for (std::size_t r = 0; r < rowCount; r++)
+        {
+            const std::uint8_t* packed = entries + r * (TILE_SIZE / 2);
+            std::uint8_t* out = rows + r * n + tileColumn * TILE_SIZE;
+            for (std::size_t byte = 0; byte < count / 2; byte++)
+            {
+                out[2 * byte] = packed[byte] & 0xf;
+                out[2 * byte + 1] = packed[byte] >> 4;
+            }
+            if (count % 2 != 0)
+            {
+                out[count - 1] = packed[count / 2] & 0xf;
+            }
+        }
+    }
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "digitmind.h"
+
+/**
+ * @brief Scores pairs of combinations of distinct digits without per-position loops.
+ *
+ * The digits of every combination are packed into one word, so the right
+ * positions are the zero bytes of the difference of two words, and the shared
+ * digits are the common bits of two digit masks.
+ */
+class PairScorer
+{
+public:
+    /**
+     * @param codes The combinations to score, which are indexed in this order.
+     */
+    explicit PairScorer(const CombinationList& codes);
+
+    /**
+     * @brief Returns the outcome index of guessing combination i for secret j.
+     */
+    std::uint8_t outcome(std::size_t i, std::size_t j) const
+    {
+        std::uint32_t difference = packed[i] ^ packed[j];
+        int right = ((difference & 0xff) == 0) + ((difference & 0xff00) == 0)
+                    + ((difference & 0xff0000) == 0) + ((difference & 0xff000000) == 0);
+        int shared = std::popcount(static_cast<std::uint16_t>(masks[i] & masks[j]));
+        return MATCH_OUTCOMES[matchCode(right, shared)];
+    }
+
+private:
+    std::vector<std::uint32_t> packed;
+    std::vector<std::uint16_t> masks;
+};
+
+/**
+ * @brief The outcome index of every pair of combinations of a level.
+ *
+ * Entry (i, j) is the outcome index of guessing combination i when the secret
+ * is combination j, in generation order. Looking a score up replaces a call to
+ * calculateScore() in the inner loops of the guess searches; the matrix of
+ * level 10 is built when its tables are published (publishLevelTables()), and
+ * every level reads it from the mapped tables.
+ *
+ * The matrix is built in square blocks of BLOCK_SIZE rows and columns, which
+ * keeps the codes and the cells being written in cache. The score of two
+ * combinations of distinct digits does not depend on which is the guess, so
+ * only the blocks on and above the diagonal are computed; every block is
+ * mirrored into its transposed block while it is still in cache. Rows of
+ * blocks are built in parallel.
+ */
+class ScoreMatrix
+{
+public:
+    /** The number of rows and columns of a block. */
+    static const std::size_t BLOCK_SIZE = 128;
+
+    /**
+     * @brief Builds the matrix of a level.
+     *
+     * @param level The difficulty level of the game.
+     */
+    explicit ScoreMatrix(int level);
+
+    /**
+     * @brief Returns the number of combinations of the level.
+     */
+    std::size_t size() const
+    {
+        return codes.size();
+    }
+
+    /**
+     * @brief Returns all combinations of the level in generation order.
+     */
+    const CombinationList& combinations() const
+    {
+        return codes;
+    }
+
+    /**
+     * @brief Returns the outcome index of a guess against a secret.
+     *
+     * @param guess The index of the guess in generation order.
+     * @param secret The index of the secret in generation order.
+     */
+    int outcome(std::size_t guess, std::size_t secret) const
+    {
+        return cells[guess * codes.size() + secret];
+    }
+
+    /**
+     * @brief Returns the outcome indices of a guess against every secret.
+     */
+    const std::uint8_t* row(std::size_t guess) const
+    {
+        return &cells[guess * codes.size()];
+    }
+
+    /**
+     * @brief Returns the memory used by the entries in bytes.
+     */
+    std::size_t bytes() const
+    {
+        return cells.size();
+    }
+
+private:
+    CombinationList codes;
+    std::vector<std::uint8_t> cells;
+};
+
+/**
+ * @brief The outcome index of every pair of combinations of a level, stored in
+ * a quarter of the memory of a ScoreMatrix.
+ *
+ * An outcome index fits in 4 bits, so two entries are packed per byte, and
+ * since the score is symmetric only the upper triangle is stored. The
+ * triangle is cut into square tiles of TILE_SIZE rows and columns, stored
+ * one after the other with their rows consecutive; the tiles on the diagonal
+ * are stored whole. At level 10 this takes about 6 MB instead of 25 MB.
+ *
+ * Single entries are looked up with outcome(). A row passes through the
+ * tiles right of the diagonal along their rows and through the tiles left of
+ * it along their columns, so batch users unpack a tile row at a time with
+ * unpackRows(): every tile is then read once, consecutively, and written to
+ * the rows of the scratch buffer while it is in cache. unpackRow() unpacks a
+ * single row for occasional use.
+ *
+ * A level whose tables cannot be attached keeps its scores in this matrix
+ * (see LevelData).
+ */
+class PackedScoreMatrix
+{
+public:
+    /** The number of rows and columns of a tile. */
+    static const std::size_t TILE_SIZE = 64;
+
+    /**
+     * @brief Builds the matrix of a level.
+     *
+     * @param level The difficulty level of the game.
+     */
+    explicit PackedScoreMatrix(int level);
+
+    /**
+     * @brief Returns the number of combinations of the level.
+     */
+    std::size_t size() const
+    {
+        return codes.size();
+    }
+
+    /**
+     * @brief Returns all combinations of the level in generation order.
+     */
+    const CombinationList& combinations() const
+    {
+        return codes;
+    }
+
+    /**
+     * @brief Returns the outcome index of a guess against a secret.
+     *
+     * @param guess The index of the guess in generation order.
+     * @param secret The index of the secret in generation order.
+     */
+    int outcome(std::size_t guess, std::size_t secret) const
+    {
+        std::size_t row = std::min(guess, secret);
+        std::size_t column = std::max(guess, secret);
+        std::size_t offset = rowOffsets[row] + column / TILE_SIZE * TILE_BYTES + column % TILE_SIZE / 2;
+        return (nibbles[offset] >> (column % 2 * 4)) & 0xf;
+    }
+
+    /**
+     * @brief Writes the outcome indices of a guess against every secret.
+     *
+     * @param guess The index of the guess in generation order.
+     * @param row The buffer to write to, of size() entries.
+     */
+    void unpackRow(std::size_t guess, std::uint8_t* row) const;
+
+    /**
+     * @brief Writes the outcome indices of the guesses of a tile row against
+     * every secret.
+     *
+     * @param tileRow The tile row; its guesses start at tileRow * TILE_SIZE.
+     * @param rows The buffer to write to, of TILE_SIZE rows of size() entries;
+     * the rows past the last guess are left unchanged.
+     */
+    void unpackRows(std::size_t tileRow, std::uint8_t* rows) const;
+
+    /**
+     * @brief Returns the number of tile rows.
+     */
+    std::size_t tileRows() const
+    {
+        return tileRowOffsets.size();
+    }
+
+    /**
+     * @brief Returns the memory used by the entries in bytes.
+     */
+    std::size_t bytes() const
+    {
+        return nibbles.size();
+    }
+
+private:
+    static const std::size_t TILE_BYTES = TILE_SIZE * TILE_SIZE / 2;
+
+    const std::uint8_t* tile(std::size_t tileRow, std::size_t tileColumn) const
+    {
+        return &nibbles[tileRowOffsets[tileRow] + (tileColumn - tileRow) * TILE_BYTES];
+    }
+
+    CombinationList codes;
+    std::vector<std::size_t> tileRowOffsets;    // Byte offset of the diagonal tile of every tile row
+    std::vector<std::size_t> rowOffsets;        // Byte offset of every row in tile column 0, as if
+                                                // its tile row started there
+    std::vector<std::uint8_t> nibbles;
+};
@@ -0,0 +1,193 @@
+#include "secret_difficulty.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <numeric>
+
+#include "cache_file.h"
+#include "level_cache.h"
+#include "parallel.h"
+
+namespace
+{
+
+const char MAGIC[8] = "DMDIFF";
+const std::uint32_t FORMAT_VERSION = 1;
+
+/**
+ * @brief Records the guesses of the secrets of a state and its subtrees.
+ */
+void measureState(Strategy strategy, int level, GameHistory& history, const CombinationList& candidates,
+                  std::vector<std::uint8_t>& guesses)
+{
+    DigitCombination guess = findBestGuess(strategy, level, history, candidates).guess;
+    int depth = static_cast<int>(history.size()) + 1;
+
+    std::array<CombinationList, NUM_OUTCOMES> buckets;
+    for (const DigitCombination& code : candidates)
+    {
+        buckets[outcomeIndex(calculateScore(guess, code))].push_back(code);
+    }
+    if (!buckets[NUM_OUTCOMES - 1].empty())
+    {
+        const CombinationList& all = levelData(level).combinations;
+        guesses[std::lower_bound(all.begin(), all.end(), guess) - all.begin()] = static_cast<std::uint8_t>(depth);
+    }
+    for (int i = 0; i < NUM_OUTCOMES - 1; i++)
+    {
+        if (!buckets[i].empty())
+        {
+            history.push_back(Move{guess, outcomeScore(i)});
+            measureState(strategy, level, history, buckets[i], guesses);
+            history.pop_back();
+        }
+    }
+}
+
+} // namespace
+
+DifficultyTable::DifficultyTable(Strategy strategy, int level, std::vector<std::uint8_t> guesses)
+    : tableStrategy(strategy), tableLevel(level), guessCounts(std::move(guesses))
+{
+}
+
+std::optional<DifficultyTable> DifficultyTable::open(const std::string& path, Strategy strategy, int level)
+{
+    std::ifstream file(path, std::ios::binary);
+    DifficultyTableHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return std::nullopt;
+    }
+
+    // Check that the file holds the guesses of this version of the strategy
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+                 && header.formatVersion == FORMAT_VERSION
+                 && header.strategy == static_cast<std::uint32_t>(strategy)
+                 && header.strategyVersion == static_cast<std::uint32_t>(strategyVersion(strategy))
+                 && header.level == static_cast<std::uint32_t>(level)
+                 && header.secretCount == levelData(level).combinations.size();
+    if (!valid)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::uint8_t> guesses(header.secretCount);
+    if (!file.read(reinterpret_cast<char*>(guesses.data()), static_cast<std::streamsize>(guesses.size())))
+    {
+        return std::nullopt;
+    }
+    return DifficultyTable(strategy, level, std::move(guesses));
+}
+
+bool DifficultyTable::write(const std::string& path) const
+{
+    DifficultyTableHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.strategy = static_cast<std::uint32_t>(tableStrategy);
+    header.strategyVersion = static_cast<std::uint32_t>(strategyVersion(tableStrategy));
+    header.level = static_cast<std::uint32_t>(tableLevel);
+    header.secretCount = guessCounts.size();
+
+    return writeCacheFile(path, [&](std::ostream& file)
+    {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(guessCounts.data()),
+                   static_cast<std::streamsize>(guessCounts.size()));
+    });
+}
+
+double DifficultyTable::averageGuesses() const
+{
+    return std::accumulate(guessCounts.begin(), guessCounts.end(), 0.0) / guessCounts.size();
+}
+
+std::vector<std::uint8_t> measureGuessCounts(Strategy strategy, int level)
+{
+    const CombinationList& all = levelData(level).combinations;
+    std::vector<std::uint8_t> guesses(all.size(), 0);
+
+    // Measure the first guess here and the subtrees of its scores in parallel;
+    // every secret is in one subtree, so no two threads write the same count
+    DigitCombination first = findBestGuess(strategy, level, GameHistory(), all).guess;
+    std::array<CombinationList, NUM_OUTCOMES> buckets;
+    for (const DigitCombination& code : all)
+    {
+        buckets[outcomeIndex(calculateScore(first, code))].push_back(code);
+    }
+    guesses[std::lower_bound(all.begin(), all.end(), first) - all.begin()] = 1;
+
+    parallelFor(NUM_OUTCOMES - 1, [&](std::size_t i)
+    {
+        if (!buckets[i].empty())
+        {
+            GameHistory history = {Move{first, outcomeScore(static_cast<int>(i))}};
+            measureState(strategy, level, history, buckets[i], guesses);
+        }
+    });
+    return guesses;
+}
+
+std::string difficultyTablePath(Strategy strategy, int level)
+{
+    return cacheFilePath(std::string("digitmind-") + strategyName(strategy) + "-" + std::to_string(level)
+                         + ".difficulty");
+}
+
+SecretSelector::SecretSelector(const DifficultyTable& table, const CombinationList& combinations)
+    : combinations(combinations)
+{
+    int average = static_cast<int>(std::lround(table.averageGuesses()));
+    std::vector<double> any(table.size(), 1.0);
+    std::vector<double> easy(table.size(), 0.0);
+    std::vector<double> medium(table.size(), 0.0);
+    std::vector<double> hard(table.size(), 0.0);
+    for (std::size_t i = 0; i < table.size(); i++)
+    {
+        int guesses = table.guesses(i);
+        if (guesses < average)
+        {
+            easy[i] = std::ldexp(1.0, average - guesses);
+        }
+        else if (guesses == average)
+        {
+            medium[i] = 1.0;
+        }
+        else
+        {
+            hard[i] = std::ldexp(1.0, guesses - average);
+        }
+    }
+
+    for (const std::vector<double>* weights : {&any, &easy, &medium, &hard})
+    {
+        bool empty = std::all_of(weights->begin(), weights->end(), [](double weight) { return weight == 0.0; });
+        tiers.emplace_back(empty ? any : *weights);
+    }
+}
+
+const SecretSelector* secretSelector(Strategy strategy, int level)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<Strategy, int>, std::optional<SecretSelector>> selectors;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto key = std::make_pair(strategy, level);
+    auto it = selectors.find(key);
+    if (it == selectors.end())
+    {
+        std::optional<SecretSelector> selector;
+        if (auto table = DifficultyTable::open(difficultyTablePath(strategy, level), strategy, level))
+        {
+            selector.emplace(*table, levelData(level).combinations);
+        }
+        it = selectors.emplace(key, std::move(selector)).first;
+    }
+    return it->second ? &*it->second : nullptr;
+}
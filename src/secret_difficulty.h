@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "alias_table.h"
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * The header at the start of every difficulty table file, followed by the
+ * number of guesses of every secret, one byte each.
+ */
+struct DifficultyTableHeader
+{
+    char magic[8];                  // "DMDIFF"
+    std::uint32_t formatVersion;    // Layout of the file
+    std::uint32_t strategy;
+    std::uint32_t strategyVersion;
+    std::uint32_t level;
+    std::uint64_t secretCount;
+};
+
+/**
+ * @brief The number of guesses a strategy needs for every secret of a level.
+ *
+ * The table is measured once by the batch solver (DigitMindSolve) and written
+ * next to the solution store; like the store, a file written by another
+ * version of the strategy, for another level or in another layout is
+ * rejected when it is opened.
+ */
+class DifficultyTable
+{
+public:
+    /**
+     * @param strategy The strategy that was measured.
+     * @param level The difficulty level of the game.
+     * @param guesses The number of guesses for every secret, in generation order.
+     */
+    DifficultyTable(Strategy strategy, int level, std::vector<std::uint8_t> guesses);
+
+    /**
+     * @brief Reads a difficulty table file.
+     *
+     * @return The table, or nothing when the file does not exist or does not
+     * match the strategy, its current version or the level.
+     */
+    static std::optional<DifficultyTable> open(const std::string& path, Strategy strategy, int level);
+
+    /**
+     * @brief Writes the table to a file with writeCacheFile().
+     *
+     * @return Whether the file was written.
+     */
+    bool write(const std::string& path) const;
+
+    Strategy strategy() const { return tableStrategy; }
+    int level() const { return tableLevel; }
+    std::size_t size() const { return guessCounts.size(); }
+
+    /**
+     * @brief Returns the number of guesses for secret i in generation order.
+     */
+    int guesses(std::size_t i) const
+    {
+        return guessCounts[i];
+    }
+
+    /**
+     * @brief Returns the average number of guesses over all secrets.
+     */
+    double averageGuesses() const;
+
+private:
+    Strategy tableStrategy;
+    int tableLevel;
+    std::vector<std::uint8_t> guessCounts;
+};
+
+/**
+ * @brief Measures the number of guesses a strategy needs for every secret.
+ *
+ * The strategy is played against all secrets at once by walking the game
+ * tree, the subtrees of the first guess in parallel. The guesses are found
+ * with findBestGuess(), so a level that was solved before is walked from the
+ * caches.
+ *
+ * @param strategy The strategy to measure; must not be Strategy::Random.
+ * @param level The difficulty level of the game.
+ * @return The number of guesses for every secret, in generation order.
+ */
+std::vector<std::uint8_t> measureGuessCounts(Strategy strategy, int level);
+
+/**
+ * @brief Returns the path of the difficulty table of a strategy and level.
+ *
+ * The files are located with cacheFilePath().
+ */
+std::string difficultyTablePath(Strategy strategy, int level);
+
+/**
+ * The difficulty tiers of secrets, relative to the average number of guesses
+ * (rounded) of the measured strategy.
+ */
+enum class SecretTier
+{
+    Any,        // Every secret equally likely
+    Easy,       // Fewer guesses than average, the fewest the most likely
+    Medium,     // The average number of guesses
+    Hard        // More guesses than average, the most the most likely
+};
+
+/**
+ * @brief Draws secrets of a difficulty tier in constant time.
+ *
+ * Within the easy and hard tiers, a secret is twice as likely as one needing
+ * one guess more (easy) or less (hard), so the extremes are served most. The
+ * weights of every tier are turned into an alias table once; drawing a secret
+ * costs a few random numbers. A tier without secrets draws from all secrets.
+ */
+class SecretSelector
+{
+public:
+    /**
+     * @param table The difficulty table of the level.
+     * @param combinations All combinations of the level in generation order.
+     */
+    SecretSelector(const DifficultyTable& table, const CombinationList& combinations);
+
+    /**
+     * @brief Draws a secret of a tier.
+     */
+    const DigitCombination& select(SecretTier tier, std::mt19937& gen) const
+    {
+        return combinations[tiers[static_cast<int>(tier)].sample(gen)];
+    }
+
+private:
+    CombinationList combinations;
+    std::vector<AliasTable> tiers;      // Indexed by SecretTier
+};
+
+/**
+ * @brief Returns the secret selector of a strategy and level, reading its
+ * difficulty table on first use.
+ *
+ * @return The selector, or nullptr when there is no valid difficulty table.
+ */
+const SecretSelector* secretSelector(Strategy strategy, int level);
@@ -0,0 +1,74 @@
+#include "secret_prior.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+
+#include "level_cache.h"
+
+SecretPrior::SecretPrior(int level, std::vector<double> weights)
+    : priorLevel(level), priorWeights(std::move(weights)), sampler(priorWeights)
+{
+}
+
+SecretPrior SecretPrior::uniform(int level)
+{
+    return SecretPrior(level, std::vector<double>(levelData(level).combinations.size(), 1.0));
+}
+
+SecretPrior SecretPrior::human(int level)
+{
+    const CombinationList& combinations = levelData(level).combinations;
+    std::vector<double> weights;
+    for (const DigitCombination& code : combinations)
+    {
+        double weight = code[0] == 0 ? 0.25 : 1.0;
+        bool increasing = true;
+        bool decreasing = true;
+        for (int i = 0; i < 3; i++)
+        {
+            if (code[i + 1] - code[i] == 1 || code[i] - code[i + 1] == 1)
+            {
+                weight *= 2.0;
+            }
+            increasing = increasing && code[i] < code[i + 1];
+            decreasing = decreasing && code[i] > code[i + 1];
+        }
+        if (increasing || decreasing)
+        {
+            weight *= 2.0;
+        }
+        weights.push_back(weight);
+    }
+    return SecretPrior(level, std::move(weights));
+}
+
+double SecretPrior::weight(const DigitCombination& combination) const
+{
+    const CombinationList& combinations = levelData(priorLevel).combinations;
+    auto it = std::lower_bound(combinations.begin(), combinations.end(), combination);
+    return priorWeights[it - combinations.begin()];
+}
+
+const DigitCombination& SecretPrior::sample(std::mt19937& gen) const
+{
+    return levelData(priorLevel).combinations[sampler.sample(gen)];
+}
+
+const SecretPrior& humanPrior(int level)
+{
+    struct Entry
+    {
+        std::once_flag built;
+        std::unique_ptr<SecretPrior> prior;
+    };
+    static std::array<Entry, MAX_LEVEL - MIN_LEVEL + 1> entries;
+
+    Entry& entry = entries[level - MIN_LEVEL];
+    std::call_once(entry.built, [&]()
+    {
+        entry.prior = std::make_unique<SecretPrior>(SecretPrior::human(level));
+    });
+    return *entry.prior;
+}
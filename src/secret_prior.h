@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "alias_table.h"
+#include "digitmind.h"
+
+/**
+ * @brief Prior weights of the secrets of a level.
+ *
+ * The weight of a secret is proportional to the probability that a codemaker
+ * picks it before any guess. The posterior of a secret after some guesses is
+ * its weight divided by the total weight of the secrets still possible, so
+ * the weights never need to be normalized.
+ */
+class SecretPrior
+{
+public:
+    /**
+     * @param level The difficulty level of the game.
+     * @param weights The positive weight of every combination of the level,
+     * in generation order.
+     */
+    SecretPrior(int level, std::vector<double> weights);
+
+    /**
+     * @brief Returns the prior in which every secret is equally likely.
+     */
+    static SecretPrior uniform(int level);
+
+    /**
+     * @brief Returns a prior modeling how people choose secrets.
+     *
+     * People avoid a leading zero and favor patterns. The weight of a secret
+     * is 1, divided by 4 when it starts with 0, doubled for every pair of
+     * adjacent digits that differ by one (so 1234 is 8 times as likely as a
+     * patternless secret) and doubled again when its digits are in increasing
+     * or decreasing order.
+     */
+    static SecretPrior human(int level);
+
+    int level() const
+    {
+        return priorLevel;
+    }
+
+    /**
+     * @brief Returns the weight of combination i of the level in generation order.
+     */
+    double weight(std::size_t i) const
+    {
+        return priorWeights[i];
+    }
+
+    /**
+     * @brief Returns the weight of a combination of the level.
+     */
+    double weight(const DigitCombination& combination) const;
+
+    const std::vector<double>& weights() const
+    {
+        return priorWeights;
+    }
+
+    /**
+     * @brief Draws a secret with the probability of the prior in constant time.
+     */
+    const DigitCombination& sample(std::mt19937& gen) const;
+
+private:
+    int priorLevel;
+    std::vector<double> priorWeights;
+    AliasTable sampler;
+};
+
+/**
+ * @brief Returns the human prior of a level, built on first use.
+ *
+ * Like levelData(), this is safe to call concurrently.
+ */
+const SecretPrior& humanPrior(int level);
@@ -0,0 +1,122 @@
+#include "soa_candidates.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace
+{
+
+/** The number of candidates whose outcome codes are computed at a time. */
+const std::size_t BLOCK_SIZE = 256;
+
+} // namespace
+
+SoACandidates::SoACandidates(const CombinationList& candidates)
+{
+    for (auto& column : columns)
+    {
+        column.reserve(candidates.size());
+    }
+    masks.reserve(candidates.size());
+
+    for (const DigitCombination& code : candidates)
+    {
+        for (int position = 0; position < 4; position++)
+        {
+            columns[position].push_back(static_cast<std::uint8_t>(code[position]));
+        }
+        masks.push_back(static_cast<std::uint16_t>(digitMask(code)));
+    }
+}
+
+void SoACandidates::outcomeCodes(const DigitCombination& guess, std::size_t begin, std::size_t end,
+                                 std::uint8_t* codes) const
+{
+    const std::uint8_t* column0 = columns[0].data();
+    const std::uint8_t* column1 = columns[1].data();
+    const std::uint8_t* column2 = columns[2].data();
+    const std::uint8_t* column3 = columns[3].data();
+    const std::uint16_t* mask = masks.data();
+    std::uint8_t digit0 = static_cast<std::uint8_t>(guess[0]);
+    std::uint8_t digit1 = static_cast<std::uint8_t>(guess[1]);
+    std::uint8_t digit2 = static_cast<std::uint8_t>(guess[2]);
+    std::uint8_t digit3 = static_cast<std::uint8_t>(guess[3]);
+    std::uint16_t guessMask = static_cast<std::uint16_t>(digitMask(guess));
+
+    for (std::size_t i = begin; i < end; i++)
+    {
+        int right = (column0[i] == digit0) + (column1[i] == digit1)
+                    + (column2[i] == digit2) + (column3[i] == digit3);
+        int shared = std::popcount(static_cast<std::uint16_t>(mask[i] & guessMask));
+        codes[i - begin] = static_cast<std::uint8_t>(matchCode(right, shared));
+    }
+}
+
+OutcomeHistogram SoACandidates::histogram(const DigitCombination& guess) const
+{
+    // Count the outcome codes, then map them onto outcome indices once
+    std::array<int, NUM_MATCH_CODES> counts{};
+    std::uint8_t codes[BLOCK_SIZE];
+    for (std::size_t begin = 0; begin < size(); begin += BLOCK_SIZE)
+    {
+        std::size_t end = std::min(begin + BLOCK_SIZE, size());
+        outcomeCodes(guess, begin, end, codes);
+        for (std::size_t i = 0; i < end - begin; i++)
+        {
+            counts[codes[i]]++;
+        }
+    }
+
+    OutcomeHistogram histogram{};
+    for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+    {
+        histogram[outcome] = counts[matchCode(outcomeScore(outcome))];
+    }
+    return histogram;
+}
+
+void SoACandidates::filter(const DigitCombination& guess, const Score& score)
+{
+    std::uint8_t wanted = static_cast<std::uint8_t>(matchCode(score));
+
+    // Move the survivors of each block forward in every column
+    std::size_t kept = 0;
+    std::uint8_t codes[BLOCK_SIZE];
+    for (std::size_t begin = 0; begin < size(); begin += BLOCK_SIZE)
+    {
+        std::size_t end = std::min(begin + BLOCK_SIZE, size());
+        outcomeCodes(guess, begin, end, codes);
+        for (std::size_t i = begin; i < end; i++)
+        {
+            if (codes[i - begin] == wanted)
+            {
+                for (auto& column : columns)
+                {
+                    column[kept] = column[i];
+                }
+                masks[kept] = masks[i];
+                kept++;
+            }
+        }
+    }
+
+    for (auto& column : columns)
+    {
+        column.resize(kept);
+    }
+    masks.resize(kept);
+}
+
+CombinationList SoACandidates::combinations() const
+{
+    CombinationList codes(size());
+    for (std::size_t i = 0; i < size(); i++)
+    {
+        for (int position = 0; position < 4; position++)
+        {
+            codes[i][position] = columns[position][i];
+        }
+    }
+    return codes;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * @brief A set of candidates stored as a structure of arrays.
+ *
+ * Every position has a contiguous column holding one byte per candidate, and
+ * a mask column holds a bit per digit contained in each candidate. Comparing
+ * a guess against many candidates then reads each column sequentially: the
+ * right positions are the sum of four byte comparisons and the shared digits
+ * are the popcount of the intersection of two digit masks. These loops carry
+ * no dependencies between candidates, so the compiler can vectorize them.
+ *
+ * Filtering compacts all columns in place in one pass, keeping the order of
+ * the survivors, so the columns never hold removed candidates.
+ */
+class SoACandidates
+{
+public:
+    /**
+     * @param candidates The candidates to store.
+     */
+    explicit SoACandidates(const CombinationList& candidates);
+
+    /**
+     * @brief Returns the number of candidates.
+     */
+    std::size_t size() const
+    {
+        return masks.size();
+    }
+
+    /**
+     * @brief Counts the candidates giving each score for a guess.
+     */
+    OutcomeHistogram histogram(const DigitCombination& guess) const;
+
+    /**
+     * @brief Removes the candidates that do not give the score for the guess.
+     */
+    void filter(const DigitCombination& guess, const Score& score);
+
+    /**
+     * @brief Returns the candidates in their original order.
+     */
+    CombinationList combinations() const;
+
+private:
+    /**
+     * @brief Computes the outcome codes of a block of candidates for a guess.
+     *
+     * The outcome code of a candidate is the matchCode() of its right
+     * positions and shared digits, which identifies the score.
+     */
+    void outcomeCodes(const DigitCombination& guess, std::size_t begin, std::size_t end,
+                      std::uint8_t* codes) const;
+
+    std::vector<std::uint8_t> columns[4];
+    std::vector<std::uint16_t> masks;
+};
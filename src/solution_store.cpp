@@ -0,0 +1,152 @@
+#include "solution_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+
+const char MAGIC[8] = "DMSOLVE";
+const std::uint32_t FORMAT_VERSION = 1;
+
+bool keyLess(const StoredSolution& a, const StoredSolution& b)
+{
+    return a.keyHigh != b.keyHigh ? a.keyHigh < b.keyHigh : a.keyLow < b.keyLow;
+}
+
+} // namespace
+
+SolutionStore::SolutionStore(MappedFile file)
+    : file(std::move(file))
+{
+    auto header = static_cast<const SolutionStoreHeader*>(this->file.data());
+    entries = reinterpret_cast<const StoredSolution*>(header + 1);
+    count = header->solutionCount;
+}
+
+std::optional<SolutionStore> SolutionStore::open(const std::string& path, Strategy strategy, int level)
+{
+    std::optional<MappedFile> file = MappedFile::open(path, sizeof(SolutionStoreHeader));
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    // Check that the file holds the solutions of this version of the strategy
+    auto header = static_cast<const SolutionStoreHeader*>(file->data());
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+                 && header->formatVersion == FORMAT_VERSION
+                 && header->strategy == static_cast<std::uint32_t>(strategy)
+                 && header->strategyVersion == static_cast<std::uint32_t>(strategyVersion(strategy))
+                 && header->level == static_cast<std::uint32_t>(level)
+                 && sizeof(SolutionStoreHeader) + header->solutionCount * sizeof(StoredSolution) <= file->size();
+    if (!valid)
+    {
+        return std::nullopt;
+    }
+
+    return SolutionStore(std::move(*file));
+}
+
+std::optional<GuessEvaluation> SolutionStore::find(const CandidateSetKey& key) const
+{
+    StoredSolution probe{};
+    probe.keyHigh = key.high;
+    probe.keyLow = key.low;
+
+    const StoredSolution* end = entries + count;
+    const StoredSolution* it = std::lower_bound(entries, end, probe, keyLess);
+    if (it == end || it->keyHigh != key.high || it->keyLow != key.low)
+    {
+        return std::nullopt;
+    }
+
+    GuessEvaluation evaluation;
+    evaluation.guess = decodeCombination(it->guess);
+    evaluation.largestBucket = it->largestBucket;
+    evaluation.bucketCount = it->bucketCount;
+    evaluation.isCandidate = it->isCandidate != 0;
+    evaluation.expectedSize = it->expectedSize;
+    evaluation.entropy = it->entropy;
+    return evaluation;
+}
+
+std::vector<StoredSolution> SolutionStore::solutions() const
+{
+    return std::vector<StoredSolution>(entries, entries + count);
+}
+
+StoredSolution makeStoredSolution(const CandidateSetKey& key, const GuessEvaluation& evaluation)
+{
+    StoredSolution solution{};
+    solution.keyHigh = key.high;
+    solution.keyLow = key.low;
+    solution.guess = encodeCombination(evaluation.guess);
+    solution.largestBucket = static_cast<std::uint16_t>(evaluation.largestBucket);
+    solution.bucketCount = static_cast<std::uint16_t>(evaluation.bucketCount);
+    solution.isCandidate = evaluation.isCandidate ? 1 : 0;
+    solution.expectedSize = static_cast<float>(evaluation.expectedSize);
+    solution.entropy = static_cast<float>(evaluation.entropy);
+    return solution;
+}
+
+bool writeSolutionStore(const std::string& path, Strategy strategy, int level,
+                        std::vector<StoredSolution> solutions)
+{
+    std::sort(solutions.begin(), solutions.end(), keyLess);
+    solutions.erase(std::unique(solutions.begin(), solutions.end(),
+                                [](const StoredSolution& a, const StoredSolution& b)
+                                {
+                                    return a.keyHigh == b.keyHigh && a.keyLow == b.keyLow;
+                                }),
+                    solutions.end());
+
+    SolutionStoreHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.strategy = static_cast<std::uint32_t>(strategy);
+    header.strategyVersion = static_cast<std::uint32_t>(strategyVersion(strategy));
+    header.level = static_cast<std::uint32_t>(level);
+    header.solutionCount = solutions.size();
+
+    return writeCacheFile(path, [&](std::ostream& file)
+    {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(solutions.data()),
+                   static_cast<std::streamsize>(solutions.size() * sizeof(StoredSolution)));
+    });
+}
+
+std::string solutionStorePath(Strategy strategy, int level)
+{
+    return cacheFilePath(std::string("digitmind-") + strategyName(strategy) + "-" + std::to_string(level)
+                         + ".solutions");
+}
+
+std::optional<GuessEvaluation> findStoredSolution(Strategy strategy, int level,
+                                                  const CombinationList& candidates)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<Strategy, int>, std::optional<SolutionStore>> stores;
+
+    const std::optional<SolutionStore>* store;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto key = std::make_pair(strategy, level);
+        auto it = stores.find(key);
+        if (it == stores.end())
+        {
+            it = stores.emplace(key, SolutionStore::open(solutionStorePath(strategy, level), strategy, level)).first;
+        }
+        store = &it->second;
+    }
+
+    if (!store->has_value())
+    {
+        return std::nullopt;
+    }
+    return (*store)->find(hashCandidateSet(candidates));
+}
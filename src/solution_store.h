@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cache_file.h"
+#include "digitmind.h"
+#include "strategy.h"
+#include "transposition_table.h"
+
+/**
+ * A solved game state as stored on disk.
+ */
+struct StoredSolution
+{
+    std::uint64_t keyHigh;        // Key of the candidate set
+    std::uint64_t keyLow;
+    std::uint16_t guess;          // Best guess, see encodeCombination()
+    std::uint16_t largestBucket;
+    std::uint16_t bucketCount;
+    std::uint16_t isCandidate;
+    float expectedSize;
+    float entropy;
+};
+
+/**
+ * The header at the start of every solution store file.
+ */
+struct SolutionStoreHeader
+{
+    char magic[8];                // "DMSOLVE"
+    std::uint32_t formatVersion;  // Layout of the file
+    std::uint32_t strategy;
+    std::uint32_t strategyVersion;
+    std::uint32_t level;
+    std::uint64_t solutionCount;
+};
+
+/**
+ * @brief A read-only, memory-mapped file of solved game states.
+ *
+ * Each file holds the solutions of one strategy at one level, sorted by key
+ * so that a lookup is a binary search in the mapped memory. The header records
+ * the version of the strategy that produced the solutions; a file written by
+ * another version, for another strategy or level, or in another layout is
+ * rejected when it is opened.
+ *
+ * The files are written by the batch solver (DigitMindSolve) with
+ * writeSolutionStore() and read by the online guess selection.
+ */
+class SolutionStore
+{
+public:
+    /**
+     * @brief Maps a solution store file.
+     *
+     * @param path The path of the file.
+     * @param strategy The strategy the solutions must be for.
+     * @param level The level the solutions must be for.
+     * @return The store, or nothing when the file does not exist or does not
+     * match the strategy, its current version or the level.
+     */
+    static std::optional<SolutionStore> open(const std::string& path, Strategy strategy, int level);
+
+    /**
+     * @brief Looks up the solution for a candidate set key.
+     *
+     * @return The solution, or nothing when the state was not solved.
+     */
+    std::optional<GuessEvaluation> find(const CandidateSetKey& key) const;
+
+    /**
+     * @brief Returns all solutions in the store.
+     */
+    std::vector<StoredSolution> solutions() const;
+
+    std::size_t size() const { return count; }
+
+private:
+    explicit SolutionStore(MappedFile file);
+
+    MappedFile file;
+    const StoredSolution* entries;
+    std::size_t count;
+};
+
+/**
+ * @brief Converts the result of a guess search into its stored form.
+ */
+StoredSolution makeStoredSolution(const CandidateSetKey& key, const GuessEvaluation& evaluation);
+
+/**
+ * @brief Writes a solution store file.
+ *
+ * The solutions are sorted and duplicate keys are removed. The file is written
+ * with writeCacheFile(), so that processes mapping the old file keep a
+ * consistent view.
+ *
+ * @param path The path of the file.
+ * @param strategy The strategy of the solutions.
+ * @param level The level of the solutions.
+ * @param solutions The solutions to write.
+ * @return Whether the file was written.
+ */
+bool writeSolutionStore(const std::string& path, Strategy strategy, int level,
+                        std::vector<StoredSolution> solutions);
+
+/**
+ * @brief Returns the path of the solution store of a strategy and level.
+ *
+ * The files are located with cacheFilePath().
+ */
+std::string solutionStorePath(Strategy strategy, int level);
+
+/**
+ * @brief Looks up a candidate set in the solution store of a strategy and level.
+ *
+ * The store is mapped on first use and stays mapped for the lifetime of the
+ * process. When there is no valid store, nothing is found.
+ */
+std::optional<GuessEvaluation> findStoredSolution(Strategy strategy, int level,
+                                                  const CombinationList& candidates);
@@ -0,0 +1,473 @@
+#include "strategy.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "bayesian.h"
+#include "candidate_set.h"
+#include "canonical.h"
+#include "level_cache.h"
+#include "lookahead.h"
+#include "partition_histograms.h"
+#include "secret_prior.h"
+#include "solution_store.h"
+#include "transposition_table.h"
+
+const char* strategyName(Strategy strategy)
+{
+    switch (strategy)
+    {
+        case Strategy::Random:
+            return "random";
+        case Strategy::Minimax:
+            return "minimax";
+        case Strategy::Entropy:
+            return "entropy";
+        case Strategy::Lookahead:
+            return "lookahead";
+        case Strategy::Bayesian:
+            return "bayesian";
+    }
+    return "unknown";
+}
+
+std::optional<Strategy> parseStrategy(const std::string& name)
+{
+    for (Strategy strategy : {Strategy::Random, Strategy::Minimax, Strategy::Entropy, Strategy::Lookahead,
+                              Strategy::Bayesian})
+    {
+        if (name == strategyName(strategy))
+        {
+            return strategy;
+        }
+    }
+    return std::nullopt;
+}
+
+int strategyVersion(Strategy strategy)
+{
+    switch (strategy)
+    {
+        case Strategy::Random:
+            return 1;
+        case Strategy::Minimax:
+            return 1;
+        case Strategy::Entropy:
+            return 1;
+        case Strategy::Lookahead:
+            return 1;
+        case Strategy::Bayesian:
+            return 1;
+    }
+    return 0;
+}
+
+GuessEvaluation evaluateGuess(const DigitCombination& guess, const CombinationList& candidates)
+{
+    OutcomeHistogram histogram{};
+    for (const DigitCombination& code : candidates)
+    {
+        histogram[outcomeIndex(calculateScore(guess, code))]++;
+    }
+    return evaluateHistogram(guess, histogram);
+}
+
+GuessEvaluation evaluateHistogram(const DigitCombination& guess, const OutcomeHistogram& histogram)
+{
+    GuessEvaluation evaluation;
+    evaluation.guess = guess;
+    evaluation.isCandidate = histogram[NUM_OUTCOMES - 1] > 0;
+
+    int count = 0;
+    for (int size : histogram)
+    {
+        count += size;
+    }
+
+    double total = static_cast<double>(count);
+    for (int i = 0; i < NUM_OUTCOMES; i++)
+    {
+        int size = histogram[i];
+        if (size == 0)
+        {
+            continue;
+        }
+
+        evaluation.bucketCount++;
+        evaluation.largestBucket = std::max(evaluation.largestBucket, size);
+
+        // The winning bucket leaves nothing to guess
+        if (i != NUM_OUTCOMES - 1)
+        {
+            evaluation.expectedSize += size * size / total;
+        }
+
+        double p = size / total;
+        evaluation.entropy -= p * std::log2(p);
+    }
+    return evaluation;
+}
+
+bool isBetterGuess(Strategy strategy, const GuessEvaluation& a, const GuessEvaluation& b)
+{
+    // Entropies and expected sizes of equally good guesses differ only by rounding
+    const double epsilon = 1e-9;
+    if (strategy == Strategy::Entropy || strategy == Strategy::Bayesian)
+    {
+        if (std::abs(a.entropy - b.entropy) > epsilon)
+        {
+            return a.entropy > b.entropy;
+        }
+    }
+    else if (strategy == Strategy::Lookahead)
+    {
+        if (std::abs(a.expectedSize - b.expectedSize) > epsilon)
+        {
+            return a.expectedSize < b.expectedSize;
+        }
+    }
+    else if (a.largestBucket != b.largestBucket)
+    {
+        return a.largestBucket < b.largestBucket;
+    }
+
+    if (a.isCandidate != b.isCandidate)
+    {
+        return a.isCandidate;
+    }
+    return a.expectedSize < b.expectedSize;
+}
+
+namespace
+{
+
+/**
+ * @brief Orders the guesses so that good minimax guesses are tried first.
+ *
+ * Guesses that can be the code come first. Within both groups, guesses are
+ * ordered by how well their digits split the candidates: a digit that occurs
+ * in half of the candidates splits them best, a digit that occurs in all or
+ * none of them does not split them at all.
+ *
+ * @param guesses The guesses to order.
+ * @param candidates The candidates, in generation order.
+ * @return The indices of the guesses in the order to try them.
+ */
+std::vector<std::size_t> orderGuesses(const CombinationList& guesses, const CombinationList& candidates)
+{
+    std::array<int, 10> presence{};
+    for (const DigitCombination& code : candidates)
+    {
+        for (int digit : code)
+        {
+            presence[digit]++;
+        }
+    }
+
+    int total = static_cast<int>(candidates.size());
+    std::vector<int> priority(guesses.size());
+    for (std::size_t g = 0; g < guesses.size(); g++)
+    {
+        int coverage = 0;
+        for (int digit : guesses[g])
+        {
+            coverage += std::min(presence[digit], total - presence[digit]);
+        }
+
+        bool consistent = std::binary_search(candidates.begin(), candidates.end(), guesses[g]);
+        priority[g] = coverage + (consistent ? 4 * total : 0);
+    }
+
+    std::vector<std::size_t> order(guesses.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+    {
+        return priority[a] > priority[b];
+    });
+    return order;
+}
+
+/**
+ * @brief Finds the digits that are interchangeable in a candidate set.
+ *
+ * Two digits are interchangeable when swapping them in every candidate gives
+ * the same set, as is the case for digits that were never guessed.
+ *
+ * @param level The difficulty level of the game.
+ * @param candidates The candidates, in generation order.
+ * @return For each digit, the smallest digit it is interchangeable with.
+ */
+std::array<int, 10> findInterchangeableDigits(int level, CombinationSpan candidates)
+{
+    std::array<int, 10> representative;
+    std::iota(representative.begin(), representative.end(), 0);
+
+    CombinationList swapped(candidates.size());
+    for (int d = 0; d < level; d++)
+    {
+        for (int e = d + 1; e < level; e++)
+        {
+            if (representative[e] != e)
+            {
+                continue;
+            }
+            for (std::size_t i = 0; i < candidates.size(); i++)
+            {
+                for (int p = 0; p < 4; p++)
+                {
+                    int digit = candidates[i][p];
+                    swapped[i][p] = digit == d ? e : digit == e ? d : digit;
+                }
+            }
+            std::sort(swapped.begin(), swapped.end());
+            if (std::equal(swapped.begin(), swapped.end(), candidates.begin(), candidates.end()))
+            {
+                representative[e] = representative[d];
+            }
+        }
+    }
+    return representative;
+}
+
+/**
+ * @brief Returns whether a guess is the first in generation order of the
+ * guesses that differ from it only by interchangeable digits.
+ *
+ * That guess uses, for every class of interchangeable digits, the smallest
+ * digits of the class in increasing order of position.
+ */
+bool isFirstOfClass(const DigitCombination& guess, const std::array<int, 10>& representative)
+{
+    std::array<int, 10> used{};
+    for (int digit : guess)
+    {
+        int expected = representative[digit];
+        while (expected < 10 && (representative[expected] != representative[digit] || used[expected]))
+        {
+            expected++;
+        }
+        if (digit != expected)
+        {
+            return false;
+        }
+        used[digit] = 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Searches for the best minimax guess, abandoning guesses early.
+ *
+ * A guess is abandoned as soon as one of its buckets holds more candidates
+ * than the largest bucket of the best guess so far, since it can no longer be
+ * better. The guesses are tried in the order of orderGuesses() so that a small
+ * bound is found early. Equally good guesses are decided by their position in
+ * generation order, which makes the result the same as that of a full search.
+ * For the same reason only the distinct guesses are evaluated.
+ */
+GuessEvaluation searchMinimax(const LevelData& data, const CombinationList& candidates)
+{
+    const CombinationList& guesses = data.combinations;
+    std::vector<char> distinct(guesses.size(), 0);
+    for (std::size_t g : selectDistinctGuesses(data.level, guesses, candidates))
+    {
+        distinct[g] = 1;
+    }
+
+    // The scores are looked up in the tables of the level by index
+    std::vector<std::size_t> secrets;
+    secrets.reserve(candidates.size());
+    for (const DigitCombination& code : candidates)
+    {
+        secrets.push_back(data.indexOf(code));
+    }
+
+    GuessEvaluation best;
+    std::size_t bestIndex = 0;
+    bool found = false;
+    for (std::size_t g : orderGuesses(guesses, candidates))
+    {
+        if (!distinct[g])
+        {
+            continue;
+        }
+
+        int limit = found ? best.largestBucket : std::numeric_limits<int>::max();
+        OutcomeHistogram histogram{};
+        bool abandoned = false;
+        for (std::size_t secret : secrets)
+        {
+            if (++histogram[data.outcome(g, secret)] > limit)
+            {
+                abandoned = true;
+                break;
+            }
+        }
+        if (abandoned)
+        {
+            continue;
+        }
+
+        GuessEvaluation evaluation = evaluateHistogram(guesses[g], histogram);
+        if (!found || isBetterGuess(Strategy::Minimax, evaluation, best)
+            || (!isBetterGuess(Strategy::Minimax, best, evaluation) && g < bestIndex))
+        {
+            best = evaluation;
+            bestIndex = g;
+            found = true;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+std::vector<std::size_t> selectDistinctGuesses(int level, const CombinationList& guesses,
+                                               CombinationSpan candidates)
+{
+    std::array<int, 10> representative = findInterchangeableDigits(level, candidates);
+
+    std::vector<std::size_t> distinct;
+    for (std::size_t g = 0; g < guesses.size(); g++)
+    {
+        if (isFirstOfClass(guesses[g], representative))
+        {
+            distinct.push_back(g);
+        }
+    }
+    return distinct;
+}
+
+GuessEvaluation searchBestGuess(Strategy strategy, int level, const CombinationList& candidates)
+{
+    // The prior decides which of the last combinations to guess
+    if (strategy == Strategy::Bayesian)
+    {
+        return searchBayesian(level, candidates, humanPrior(level));
+    }
+
+    // With one or two combinations left, guessing one of them is optimal
+    if (candidates.size() <= 2)
+    {
+        return evaluateGuess(candidates.front(), candidates);
+    }
+
+    if (strategy == Strategy::Lookahead)
+    {
+        return searchLookahead(level, candidates);
+    }
+
+    const LevelData& data = levelData(level);
+    if (strategy == Strategy::Minimax)
+    {
+        return searchMinimax(data, candidates);
+    }
+
+    CandidateSet candidateSet(candidates);
+    GuessEvaluation best;
+    bool found = false;
+    for (const DigitCombination& guess : data.combinations)
+    {
+        GuessEvaluation evaluation = evaluateHistogram(guess, candidateSet.histogram(guess));
+        if (!found || isBetterGuess(strategy, evaluation, best))
+        {
+            best = evaluation;
+            found = true;
+        }
+    }
+    return best;
+}
+
+namespace
+{
+
+/**
+ * @brief Looks up a candidate set in the transposition table and the solution store.
+ */
+std::optional<GuessEvaluation> findCachedGuess(Strategy strategy, int level, const CombinationList& candidates)
+{
+    TranspositionTable& table = sharedTranspositionTable();
+    if (auto cached = table.find(strategy, level, candidates))
+    {
+        return cached;
+    }
+
+    if (auto stored = findStoredSolution(strategy, level, candidates))
+    {
+        table.insert(strategy, level, candidates, *stored);
+        return stored;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+GuessEvaluation findBestGuess(Strategy strategy, int level, const CombinationList& candidates)
+{
+    if (auto cached = findCachedGuess(strategy, level, candidates))
+    {
+        return *cached;
+    }
+
+    GuessEvaluation best = searchBestGuess(strategy, level, candidates);
+    if (best.isComplete)
+    {
+        sharedTranspositionTable().insert(strategy, level, candidates, best);
+    }
+    return best;
+}
+
+GuessEvaluation findBestGuess(Strategy strategy, int level, const GameHistory& history,
+                              const CombinationList& candidates, PartitionHistograms* histograms)
+{
+    // The prior tells digits and positions apart, so states are only shared
+    // when their candidates are identical
+    if (strategy == Strategy::Bayesian)
+    {
+        return findBestGuess(strategy, level, candidates);
+    }
+
+    CanonicalState canonical = canonicalize(level, history, candidates);
+    if (auto cached = findCachedGuess(strategy, level, canonical.candidates))
+    {
+        cached->guess = canonical.symmetry.invert(cached->guess);
+        return *cached;
+    }
+
+    // Search in the labeling of the game, where the histograms apply. The
+    // lookahead needs the candidates of every bucket and cannot use them; the
+    // pruned minimax search abandons most guesses after a few candidates,
+    // which is cheaper than keeping the histograms of all guesses
+    GuessEvaluation best;
+    if (histograms != nullptr && strategy == Strategy::Entropy)
+    {
+        histograms->prepare(candidates);
+        best = searchBestGuess(strategy, *histograms, candidates);
+    }
+    else
+    {
+        best = searchBestGuess(strategy, level, candidates);
+    }
+
+    if (best.isComplete)
+    {
+        GuessEvaluation canonicalBest = best;
+        canonicalBest.guess = canonical.symmetry.apply(best.guess);
+        sharedTranspositionTable().insert(strategy, level, canonical.candidates, canonicalBest);
+    }
+    return best;
+}
+
+DigitCombination selectGuess(Strategy strategy, int level, const GameHistory& history,
+                             const CombinationList& candidates, PartitionHistograms* histograms)
+{
+    if (strategy == Strategy::Random)
+    {
+        return selectRandomCombination(candidates);
+    }
+    return findBestGuess(strategy, level, history, candidates, histograms).guess;
+}
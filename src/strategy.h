@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "digitmind.h"
+
+class PartitionHistograms;
+
+/**
+ * The strategies the computer can use to choose its next guess.
+ */
+enum class Strategy
+{
+    Random,     // Guess a random possible combination
+    Minimax,    // Minimize the largest number of remaining combinations
+    Entropy,    // Maximize the information gained by the score
+    Lookahead,  // Minimize the expected number of remaining combinations after two guesses
+    Bayesian    // Maximize the information gained when secrets are chosen like people do
+};
+
+/**
+ * @brief Returns the name of a strategy as shown to the user.
+ *
+ * @param strategy The strategy.
+ * @return The name of the strategy.
+ */
+const char* strategyName(Strategy strategy);
+
+/**
+ * @brief Finds the strategy with the given name.
+ *
+ * @param name The name of the strategy, as returned by strategyName().
+ * @return The strategy, or nothing when there is no strategy with the name.
+ */
+std::optional<Strategy> parseStrategy(const std::string& name);
+
+/**
+ * @brief Returns the version of the guess selection of a strategy.
+ *
+ * The version must be incremented whenever a change makes the strategy choose
+ * different guesses, so that results stored on disk by an older version are
+ * no longer used.
+ *
+ * @param strategy The strategy.
+ * @return The version of the strategy.
+ */
+int strategyVersion(Strategy strategy);
+
+/**
+ * @brief The result of evaluating a guess against the possible combinations.
+ */
+struct GuessEvaluation
+{
+    DigitCombination guess;
+    int largestBucket;      // Worst-case number of remaining combinations
+    int bucketCount;        // Number of different scores the guess can receive
+    double expectedSize;    // Expected number of remaining combinations
+    double entropy;         // Information gained by the score in bits
+    bool isCandidate;       // Whether the guess itself can be the code
+    bool isComplete;        // Whether the search was not cut short by its time budget
+
+    GuessEvaluation() : guess{}, largestBucket(0), bucketCount(0),
+                        expectedSize(0.0), entropy(0.0), isCandidate(false), isComplete(true) {}
+};
+
+/**
+ * The number of possible combinations giving each score for a guess, indexed
+ * by outcome index.
+ *
+ * @see outcomeIndex
+ */
+typedef std::array<int, NUM_OUTCOMES> OutcomeHistogram;
+
+/**
+ * @brief Evaluates a guess against the possible combinations.
+ *
+ * The possible combinations are partitioned by the score they would give for
+ * the guess and the sizes of the partitions are summarized.
+ *
+ * @param guess The guess to evaluate.
+ * @param candidates The combinations that are still possible.
+ * @return The evaluation of the guess.
+ */
+GuessEvaluation evaluateGuess(const DigitCombination& guess, const CombinationList& candidates);
+
+/**
+ * @brief Evaluates a guess from the histogram of its scores.
+ *
+ * @param guess The guess to evaluate.
+ * @param histogram The number of possible combinations giving each score.
+ * @return The evaluation of the guess.
+ */
+GuessEvaluation evaluateHistogram(const DigitCombination& guess, const OutcomeHistogram& histogram);
+
+/**
+ * @brief Returns whether evaluation `a` is better than `b` for a strategy.
+ *
+ * Minimax prefers the smallest worst case, Entropy and Bayesian the largest
+ * information gain and Lookahead, for a single step, the smallest expected number of
+ * remaining combinations. Ties are broken in favor of guesses that can be the code and then by
+ * the expected number of remaining combinations.
+ *
+ * @param strategy The strategy comparing the evaluations.
+ * @param a The first evaluation.
+ * @param b The second evaluation.
+ * @return Whether `a` is strictly better than `b`.
+ */
+bool isBetterGuess(Strategy strategy, const GuessEvaluation& a, const GuessEvaluation& b);
+
+/**
+ * @brief Selects the guesses that split the candidates in distinct ways.
+ *
+ * Two digits are interchangeable when swapping them in every candidate gives
+ * the same set, as is the case for digits that were never guessed. Guesses
+ * that differ only by interchangeable digits split the candidates the same
+ * way, so only the first of them in generation order needs to be evaluated.
+ *
+ * @param level The difficulty level of the game.
+ * @param guesses All combinations of the level, in generation order.
+ * @param candidates The candidates, in generation order.
+ * @return The indices of the guesses to evaluate, in increasing order.
+ */
+std::vector<std::size_t> selectDistinctGuesses(int level, const CombinationList& guesses,
+                                               CombinationSpan candidates);
+
+/**
+ * @brief Searches all combinations of the level for the best next guess.
+ *
+ * This performs the full search without consulting any cache.
+ *
+ * @param strategy The strategy to use; must not be Strategy::Random.
+ * @param level The difficulty level of the game.
+ * @param candidates The combinations that are still possible; not empty.
+ * @return The evaluation of the best guess.
+ */
+GuessEvaluation searchBestGuess(Strategy strategy, int level, const CombinationList& candidates);
+
+/**
+ * @brief Finds the best next guess, using the caches where possible.
+ *
+ * The shared transposition table is consulted first, so that a candidate set
+ * that was already searched by any game in the process is answered without
+ * searching again. On a miss the solutions stored on disk are consulted and
+ * only then a full search is performed. The result is added to the table,
+ * unless the search was cut short by its time budget, since such a result
+ * depends on the speed of the machine.
+ *
+ * @param strategy The strategy to use; must not be Strategy::Random.
+ * @param level The difficulty level of the game.
+ * @param candidates The combinations that are still possible; not empty.
+ * @return The evaluation of the best guess.
+ *
+ * @see TranspositionTable
+ * @see SolutionStore
+ */
+GuessEvaluation findBestGuess(Strategy strategy, int level, const CombinationList& candidates);
+
+/**
+ * @brief Finds the best next guess for a game state, sharing the caches
+ * between isomorphic states.
+ *
+ * The state is brought into canonical form, the best guess for the canonical
+ * candidate set is found and mapped back to the labeling of the game. Games
+ * that differ only by a relabeling of the digits or a permutation of the
+ * positions therefore share their cache entries.
+ *
+ * When the state is not cached, the entropy strategy searches the partition
+ * histograms of the game, if it maintains them, instead of scoring
+ * candidates. Minimax uses its pruned search, which is cheaper than keeping
+ * the histograms; the other strategies score the candidates.
+ *
+ * @param strategy The strategy to use; must not be Strategy::Random.
+ * @param level The difficulty level of the game.
+ * @param history The moves that led to the state.
+ * @param candidates The combinations that are still possible; not empty.
+ * @param histograms The partition histograms of the game, or nullptr.
+ * @return The evaluation of the best guess.
+ *
+ * @see canonicalize
+ * @see PartitionHistograms
+ */
+GuessEvaluation findBestGuess(Strategy strategy, int level, const GameHistory& history,
+                              const CombinationList& candidates, PartitionHistograms* histograms = nullptr);
+
+/**
+ * @brief Selects the next guess of the computer.
+ *
+ * @param strategy The strategy to use.
+ * @param level The difficulty level of the game.
+ * @param history The moves that led to the state.
+ * @param candidates The combinations that are still possible; not empty.
+ * @param histograms The partition histograms of the game, or nullptr.
+ * @return The selected guess.
+ *
+ * @see findBestGuess
+ */
+DigitCombination selectGuess(Strategy strategy, int level, const GameHistory& history,
+                             const CombinationList& candidates, PartitionHistograms* histograms = nullptr);
@@ -0,0 +1,217 @@
+#include "transposition_table.h"
+
+namespace
+{
+
+// Finalizer of the SplitMix64 generator, used to mix the hash state
+std::uint64_t mix(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+CandidateSetKey hashCandidateSet(CombinationSpan candidates)
+{
+    // Two independently seeded hash chains form the two halves of the key
+    std::uint64_t high = 0x243f6a8885a308d3ULL;
+    std::uint64_t low = 0x13198a2e03707344ULL;
+    for (const DigitCombination& combination : candidates)
+    {
+        std::uint64_t code = encodeCombination(combination);
+        high = mix(high ^ code);
+        low = mix(low + code * 0xa4093822299f31d0ULL);
+    }
+    return CandidateSetKey{mix(high ^ candidates.size()), mix(low + candidates.size())};
+}
+
+TranspositionTable::TranspositionTable(std::size_t capacityBytes, std::size_t shardCount, Hasher hasher)
+    : shardCapacity(capacityBytes / shardCount), hasher(hasher)
+{
+    for (std::size_t i = 0; i < shardCount; i++)
+    {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+std::optional<GuessEvaluation> TranspositionTable::find(Strategy strategy, int level,
+                                                        const CombinationList& candidates)
+{
+    CandidateSetKey key = makeKey(strategy, level, candidates);
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end())
+    {
+        shard.statistics.misses++;
+        return std::nullopt;
+    }
+
+    Entry& entry = shard.slots[it->second];
+    if (!matches(entry, strategy, level, candidates))
+    {
+        shard.statistics.collisions++;
+        shard.statistics.misses++;
+        return std::nullopt;
+    }
+
+    entry.referenced = true;
+    shard.statistics.hits++;
+    return entry.result;
+}
+
+void TranspositionTable::insert(Strategy strategy, int level, const CombinationList& candidates,
+                                const GuessEvaluation& result)
+{
+    std::size_t bytes = entryBytes(candidates.size());
+    if (bytes > shardCapacity)
+    {
+        return;
+    }
+
+    CandidateSetKey key = makeKey(strategy, level, candidates);
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Replace an entry with the same key, whether it is the same set or a collision
+    auto existing = shard.index.find(key);
+    if (existing != shard.index.end())
+    {
+        evict(shard, existing->second);
+    }
+
+    // Advance the clock hand until the new entry fits
+    while (shard.bytes + bytes > shardCapacity)
+    {
+        shard.hand = shard.hand % shard.slots.size();
+        Entry& entry = shard.slots[shard.hand];
+        if (entry.occupied && entry.referenced)
+        {
+            entry.referenced = false;
+        }
+        else if (entry.occupied)
+        {
+            evict(shard, shard.hand);
+            shard.statistics.evictions++;
+        }
+        shard.hand++;
+    }
+
+    std::size_t slot;
+    if (shard.freeSlots.empty())
+    {
+        slot = shard.slots.size();
+        shard.slots.emplace_back();
+    }
+    else
+    {
+        slot = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+    }
+
+    Entry& entry = shard.slots[slot];
+    entry.key = key;
+    entry.strategy = strategy;
+    entry.level = level;
+    entry.codes.clear();
+    entry.codes.reserve(candidates.size());
+    for (const DigitCombination& combination : candidates)
+    {
+        entry.codes.push_back(encodeCombination(combination));
+    }
+    entry.result = result;
+    entry.referenced = false;
+    entry.occupied = true;
+
+    shard.index.emplace(key, slot);
+    shard.bytes += bytes;
+    shard.statistics.entries++;
+}
+
+void TranspositionTable::clear()
+{
+    for (auto& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->slots.clear();
+        shard->freeSlots.clear();
+        shard->hand = 0;
+        shard->bytes = 0;
+        shard->statistics.entries = 0;
+    }
+}
+
+TranspositionTable::Statistics TranspositionTable::statistics() const
+{
+    Statistics total;
+    for (const auto& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total.hits += shard->statistics.hits;
+        total.misses += shard->statistics.misses;
+        total.collisions += shard->statistics.collisions;
+        total.evictions += shard->statistics.evictions;
+        total.entries += shard->statistics.entries;
+        total.bytes += shard->bytes;
+    }
+    return total;
+}
+
+CandidateSetKey TranspositionTable::makeKey(Strategy strategy, int level,
+                                            const CombinationList& candidates) const
+{
+    CandidateSetKey key = hasher(candidates);
+    key.high ^= mix(static_cast<std::uint64_t>(strategy) << 8 | static_cast<std::uint64_t>(level));
+    return key;
+}
+
+TranspositionTable::Shard& TranspositionTable::shardFor(const CandidateSetKey& key)
+{
+    return *shards[key.high % shards.size()];
+}
+
+std::size_t TranspositionTable::entryBytes(std::size_t codeCount)
+{
+    return sizeof(Entry) + codeCount * sizeof(std::uint16_t);
+}
+
+bool TranspositionTable::matches(const Entry& entry, Strategy strategy, int level,
+                                 const CombinationList& candidates)
+{
+    if (entry.strategy != strategy || entry.level != level || entry.codes.size() != candidates.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        if (entry.codes[i] != encodeCombination(candidates[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TranspositionTable::evict(Shard& shard, std::size_t slot)
+{
+    Entry& entry = shard.slots[slot];
+    shard.index.erase(entry.key);
+    shard.bytes -= entryBytes(entry.codes.size());
+    shard.statistics.entries--;
+
+    entry.codes = std::vector<std::uint16_t>();
+    entry.occupied = false;
+    shard.freeSlots.push_back(slot);
+}
+
+TranspositionTable& sharedTranspositionTable()
+{
+    // Large enough for every mid-game state of a few thousand games at level 10
+    static TranspositionTable table(64 * 1024 * 1024);
+    return table;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "digitmind.h"
+#include "strategy.h"
+
+/**
+ * A 128-bit hash identifying a set of combinations.
+ */
+struct CandidateSetKey
+{
+    std::uint64_t high;
+    std::uint64_t low;
+
+    bool operator==(const CandidateSetKey& other) const
+    {
+        return high == other.high && low == other.low;
+    }
+};
+
+/**
+ * @brief Hashes keys in unordered containers; the low half of a key is already
+ * well mixed.
+ */
+template <>
+struct std::hash<CandidateSetKey>
+{
+    std::size_t operator()(const CandidateSetKey& key) const
+    {
+        return static_cast<std::size_t>(key.low);
+    }
+};
+
+/**
+ * @brief Encodes a combination as the decimal number formed by its digits.
+ *
+ * The encoding is the same at every level, which makes it suitable for keys
+ * that must not depend on the order of a combination list.
+ *
+ * @param combination The combination to encode.
+ * @return The encoded combination, in the range [0, 9999].
+ */
+inline std::uint16_t encodeCombination(const DigitCombination& combination)
+{
+    return static_cast<std::uint16_t>(combination[0] * 1000 + combination[1] * 100
+                                      + combination[2] * 10 + combination[3]);
+}
+
+/**
+ * @brief Decodes a combination encoded by encodeCombination().
+ *
+ * @param code The encoded combination.
+ * @return The combination.
+ */
+inline DigitCombination decodeCombination(std::uint16_t code)
+{
+    return DigitCombination{code / 1000, code / 100 % 10, code / 10 % 10, code % 10};
+}
+
+/**
+ * @brief Calculates the 128-bit hash of a set of combinations.
+ *
+ * The combinations are hashed in list order. Since filterCombinations()
+ * preserves the order of generateAllCombinations(), the same candidate set
+ * always yields the same key, however it was reached.
+ *
+ * @param candidates The set of combinations.
+ * @return The key of the set.
+ */
+CandidateSetKey hashCandidateSet(CombinationSpan candidates);
+
+/**
+ * @brief A concurrent cache of guess-selection results.
+ *
+ * Results are keyed by strategy, level and the 128-bit hash of the candidate
+ * set. Every entry also keeps the encoded candidate set itself, so that a
+ * hash collision is detected and treated as a miss instead of returning the
+ * guess for a different set.
+ *
+ * The table is split into shards with their own lock, so that concurrent
+ * games rarely contend. Each shard holds at most its share of the byte budget
+ * and makes room for new entries with the clock algorithm: the hand sweeps
+ * over the entries, giving a second chance to those that were used since the
+ * last sweep and evicting the first one that was not.
+ */
+class TranspositionTable
+{
+public:
+    struct Statistics
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t collisions = 0;
+        std::size_t evictions = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+    };
+
+    /** A function computing the key of a candidate set. */
+    using Hasher = CandidateSetKey (*)(CombinationSpan candidates);
+
+    /**
+     * @param capacityBytes The maximum memory used by the entries.
+     * @param shardCount The number of independently locked shards.
+     * @param hasher The key of the candidate sets; a weaker hash lets tests
+     * provoke collisions.
+     */
+    explicit TranspositionTable(std::size_t capacityBytes, std::size_t shardCount = 16,
+                                Hasher hasher = hashCandidateSet);
+
+    /**
+     * @brief Looks up the result for a candidate set.
+     *
+     * @return The cached result, or nothing when the set was not cached.
+     */
+    std::optional<GuessEvaluation> find(Strategy strategy, int level, const CombinationList& candidates);
+
+    /**
+     * @brief Stores the result for a candidate set, evicting as needed.
+     *
+     * Results for sets that would take more than a shard's budget are not
+     * stored.
+     */
+    void insert(Strategy strategy, int level, const CombinationList& candidates,
+                const GuessEvaluation& result);
+
+    /**
+     * @brief Removes all entries.
+     */
+    void clear();
+
+    Statistics statistics() const;
+
+private:
+    struct Entry
+    {
+        CandidateSetKey key;
+        Strategy strategy;
+        int level;
+        std::vector<std::uint16_t> codes;
+        GuessEvaluation result;
+        bool referenced;
+        bool occupied;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<CandidateSetKey, std::size_t> index;
+        std::vector<Entry> slots;
+        std::vector<std::size_t> freeSlots;
+        std::size_t hand = 0;
+        std::size_t bytes = 0;
+        Statistics statistics;
+    };
+
+    CandidateSetKey makeKey(Strategy strategy, int level, const CombinationList& candidates) const;
+    Shard& shardFor(const CandidateSetKey& key);
+    static std::size_t entryBytes(std::size_t codeCount);
+    static bool matches(const Entry& entry, Strategy strategy, int level, const CombinationList& candidates);
+    static void evict(Shard& shard, std::size_t slot);
+
+    std::size_t shardCapacity;
+    Hasher hasher;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+/**
+ * @brief Returns the transposition table shared by all games in the process.
+ */
+TranspositionTable& sharedTranspositionTable();
@@ -0,0 +1,235 @@
+#include "weighted_candidates.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "level_cache.h"
+
+WeightedCandidates::WeightedCandidates(const CombinationList& candidates, const SecretPrior& prior,
+                                       std::size_t packedBelow)
+    : prior(&prior), levelCodes(&levelData(prior.level()).combinations),
+      packedBelow(std::min<std::size_t>(packedBelow, 256))
+{
+    if (candidates.size() >= this->packedBelow || !buildPacked(candidates))
+    {
+        buildClasses(candidates);
+    }
+}
+
+void WeightedCandidates::buildClasses(const CombinationList& candidates)
+{
+    std::map<double, CombinationList, std::greater<double>> byWeight;
+    for (const DigitCombination& code : candidates)
+    {
+        byWeight[prior->weight(code)].push_back(code);
+    }
+    for (const auto& [weight, codes] : byWeight)
+    {
+        classes.push_back(WeightClass{weight, CandidateSet(codes)});
+    }
+}
+
+bool WeightedCandidates::buildPacked(const CombinationList& candidates)
+{
+    std::vector<double> weights;
+    for (const DigitCombination& code : candidates)
+    {
+        weights.push_back(prior->weight(code));
+    }
+    std::sort(weights.begin(), weights.end(), std::greater<double>());
+    weights.erase(std::unique(weights.begin(), weights.end()), weights.end());
+    if (weights.size() > MAX_PACKED_WEIGHTS)
+    {
+        return false;
+    }
+
+    classes.clear();
+    planes.emplace(candidates);
+    packedWeights = std::move(weights);
+    shifts.assign(planes->wordCount() * 64, 0);
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        std::size_t byte = std::find(packedWeights.begin(), packedWeights.end(), prior->weight(candidates[i]))
+                           - packedWeights.begin();
+        shifts[i] = static_cast<std::uint8_t>(8 * byte);
+    }
+    return true;
+}
+
+std::size_t WeightedCandidates::size() const
+{
+    if (usesPackedCounts())
+    {
+        return planes->size();
+    }
+
+    std::size_t total = 0;
+    for (const WeightClass& weightClass : classes)
+    {
+        total += weightClass.candidates.size();
+    }
+    return total;
+}
+
+double WeightedCandidates::totalWeight() const
+{
+    double total = 0.0;
+    if (usesPackedCounts())
+    {
+        forEachLive([&](std::size_t i)
+        {
+            total += packedWeights[shifts[i] / 8];
+        });
+        return total;
+    }
+
+    for (const WeightClass& weightClass : classes)
+    {
+        total += weightClass.weight * weightClass.candidates.size();
+    }
+    return total;
+}
+
+WeightedHistogram WeightedCandidates::histogram(const DigitCombination& guess) const
+{
+    WeightedHistogram histogram{};
+    if (usesPackedCounts())
+    {
+        std::array<std::uint64_t, NUM_OUTCOMES> packed = planes->groupHistogram(guess, shifts.data());
+        for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+        {
+            std::uint64_t bytes = packed[outcome];
+            if (bytes == 0)
+            {
+                continue;
+            }
+
+            // The bytes add up to fewer than 256 candidates, so the sum fits the top byte
+            histogram.counts[outcome] = static_cast<int>((bytes * 0x0101010101010101) >> 56);
+            for (std::size_t weight = 0; weight < packedWeights.size(); weight++)
+            {
+                histogram.weights[outcome] += packedWeights[weight] * ((bytes >> (8 * weight)) & 0xff);
+            }
+        }
+        return histogram;
+    }
+
+    for (const WeightClass& weightClass : classes)
+    {
+        OutcomeHistogram counts = weightClass.candidates.histogram(guess);
+        for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+        {
+            histogram.counts[outcome] += counts[outcome];
+            histogram.weights[outcome] += weightClass.weight * counts[outcome];
+        }
+    }
+    return histogram;
+}
+
+WeightedHistogram WeightedCandidates::histogram(std::size_t guess) const
+{
+    return histogram((*levelCodes)[guess]);
+}
+
+void WeightedCandidates::filter(const DigitCombination& guess, const Score& score)
+{
+    if (usesPackedCounts())
+    {
+        // Rebuild the planes and masks when few live candidates are left in them
+        planes->filter(guess, score);
+        if (planes->size() < CandidateSetOptions().compactBelow * planes->capacity())
+        {
+            buildPacked(planes->combinations());
+        }
+        return;
+    }
+
+    for (WeightClass& weightClass : classes)
+    {
+        weightClass.candidates.filter(guess, score);
+    }
+    std::erase_if(classes, [](const WeightClass& weightClass)
+    {
+        return weightClass.candidates.size() == 0;
+    });
+
+    if (size() < packedBelow)
+    {
+        CombinationList candidates;
+        for (const WeightClass& weightClass : classes)
+        {
+            CombinationList classCodes = weightClass.candidates.combinations();
+            candidates.insert(candidates.end(), classCodes.begin(), classCodes.end());
+        }
+        std::sort(candidates.begin(), candidates.end());
+        buildPacked(candidates);
+    }
+}
+
+DigitCombination WeightedCandidates::mostProbable() const
+{
+    if (usesPackedCounts())
+    {
+        // The lowest byte counts the highest weight
+        std::size_t best = 0;
+        bool found = false;
+        forEachLive([&](std::size_t i)
+        {
+            if (!found || shifts[i] < shifts[best])
+            {
+                best = i;
+                found = true;
+            }
+        });
+        return planes->combination(best);
+    }
+    return classes.front().candidates.combinations().front();
+}
+
+double WeightedCandidates::highestWeight() const
+{
+    if (usesPackedCounts())
+    {
+        std::uint8_t lowest = 8 * MAX_PACKED_WEIGHTS;
+        forEachLive([&](std::size_t i)
+        {
+            lowest = std::min(lowest, shifts[i]);
+        });
+        return packedWeights[lowest / 8];
+    }
+    return classes.front().weight;
+}
+
+GuessEvaluation evaluateWeightedHistogram(const DigitCombination& guess, const WeightedHistogram& histogram)
+{
+    GuessEvaluation evaluation;
+    evaluation.guess = guess;
+    evaluation.isCandidate = histogram.counts[NUM_OUTCOMES - 1] > 0;
+
+    double total = 0.0;
+    for (double weight : histogram.weights)
+    {
+        total += weight;
+    }
+
+    for (int i = 0; i < NUM_OUTCOMES; i++)
+    {
+        if (histogram.counts[i] == 0)
+        {
+            continue;
+        }
+
+        evaluation.bucketCount++;
+        evaluation.largestBucket = std::max(evaluation.largestBucket, histogram.counts[i]);
+
+        // The winning bucket leaves nothing to guess
+        double p = histogram.weights[i] / total;
+        if (i != NUM_OUTCOMES - 1)
+        {
+            evaluation.expectedSize += p * histogram.counts[i];
+        }
+        evaluation.entropy -= p * std::log2(p);
+    }
+    return evaluation;
+}
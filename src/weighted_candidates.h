@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "bitsliced.h"
+#include "candidate_set.h"
+#include "digitmind.h"
+#include "secret_prior.h"
+#include "strategy.h"
+
+/**
+ * The candidates giving each score for a guess, indexed by outcome index:
+ * their number and their total prior weight.
+ */
+struct WeightedHistogram
+{
+    OutcomeHistogram counts;
+    std::array<double, NUM_OUTCOMES> weights;
+};
+
+/**
+ * @brief A set of candidates with prior weights, which gives the weighted
+ * score histograms of guesses.
+ *
+ * Summing a weight per candidate would turn every popcount of the bit-sliced
+ * histogram into a loop over bits. Priors are built from a few factors, so
+ * the candidates have few distinct weights; a large set keeps the candidates
+ * of every weight in a CandidateSet of their own, and the weighted histogram
+ * is the sum of the unweighted histograms of the sets times their weights.
+ * The sets hold the candidates between them, so this scans about as many
+ * words as a single set. A smaller set would pay the fixed cost of a
+ * histogram once per weight; it is held in a single set of bitplanes
+ * instead, whose right and shared counts are transposed into a byte per
+ * candidate, eight candidates at a time. Every candidate then adds one to the
+ * byte of its weight in a word per score, so the candidates of up to
+ * MAX_PACKED_WEIGHTS weights are counted by integer adds alone, and the counts
+ * and weights of the scores follow from these bytes once per guess. A byte
+ * counts at most 255 candidates, which bounds the size of such a set.
+ */
+class WeightedCandidates
+{
+public:
+    /**
+     * @param candidates The candidates, in generation order.
+     * @param prior The prior of the level of the candidates.
+     * @param packedBelow The number of candidates below which packed counts
+     * are used, if the candidates have few enough weights; at most 256.
+     */
+    WeightedCandidates(const CombinationList& candidates, const SecretPrior& prior,
+                       std::size_t packedBelow = 200);
+
+    /**
+     * @brief Returns the number of candidates.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the total prior weight of the candidates.
+     */
+    double totalWeight() const;
+
+    /**
+     * @brief Counts and weighs the candidates giving each score for a guess.
+     */
+    WeightedHistogram histogram(const DigitCombination& guess) const;
+
+    /**
+     * @brief Counts and weighs the candidates giving each score for
+     * combination i of the level in generation order.
+     */
+    WeightedHistogram histogram(std::size_t guess) const;
+
+    /**
+     * @brief Removes the candidates that do not give the score for the guess.
+     */
+    void filter(const DigitCombination& guess, const Score& score);
+
+    /**
+     * @brief Returns the candidate with the highest posterior probability, the
+     * first in generation order among equally likely ones; not empty.
+     */
+    DigitCombination mostProbable() const;
+
+    /**
+     * @brief Returns the prior weight of the most probable candidate.
+     */
+    double highestWeight() const;
+
+    /**
+     * @brief Returns whether the candidates are counted in packed bytes.
+     */
+    bool usesPackedCounts() const
+    {
+        return planes.has_value();
+    }
+
+    static constexpr std::size_t MAX_PACKED_WEIGHTS = 8;   // Weights a word of packed counts has bytes for
+
+private:
+    struct WeightClass
+    {
+        double weight;
+        CandidateSet candidates;
+    };
+
+    void buildClasses(const CombinationList& candidates);
+    bool buildPacked(const CombinationList& candidates);
+
+    /**
+     * @brief Calls visit(i) for every live candidate i of the planes, in order.
+     */
+    template <typename Visit>
+    void forEachLive(Visit&& visit) const
+    {
+        for (std::size_t word = 0; word < planes->wordCount(); word++)
+        {
+            for (std::uint64_t bits = planes->live(word); bits != 0; bits &= bits - 1)
+            {
+                visit(word * 64 + std::countr_zero(bits));
+            }
+        }
+    }
+
+    const SecretPrior* prior;
+    const CombinationList* levelCodes;          // All combinations of the level, in generation order
+    std::size_t packedBelow;
+    std::vector<WeightClass> classes;           // By decreasing weight, none empty; or empty for packed counts
+    std::optional<BitSlicedCandidates> planes;  // The candidates in generation order, for packed counts
+    std::vector<double> packedWeights;          // The weight counted by every byte, decreasing
+    std::vector<std::uint8_t> shifts;           // The bit offset of the byte of every candidate of the planes
+};
+
+/**
+ * @brief Evaluates a guess from its weighted histogram.
+ *
+ * The information gained is the entropy of the score under the posterior,
+ * and the expected number of remaining combinations weighs every score by
+ * its posterior probability. The largest bucket and the bucket count are
+ * those of the unweighted histogram.
+ *
+ * @param guess The guess to evaluate.
+ * @param histogram The weighted histogram of the guess.
+ * @return The evaluation of the guess.
+ */
+GuessEvaluation evaluateWeightedHistogram(const DigitCombination& guess, const WeightedHistogram& histogram);
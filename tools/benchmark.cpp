@@ -0,0 +1,657 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "bitsliced.h"
+#include "candidate_set.h"
+#include "compiled_history.h"
+#include "compressed_set.h"
+#include "digitmind.h"
+#include "filter_pipeline.h"
+#include "game_analysis.h"
+#include "inverted_index.h"
+#include "level_tables.h"
+#include "parallel.h"
+#include "score_matrix.h"
+#include "secret_difficulty.h"
+#include "secret_prior.h"
+#include "soa_candidates.h"
+#include "weighted_candidates.h"
+#include "strategy.h"
+
+/**
+ * Benchmarks of the DigitMind kernels.
+ *
+ * For every level, the time to build each table is measured as the best of
+ * several repetitions, next to the straightforward computation it replaces.
+ *
+ * Usage: DigitMindBenchmark [repetitions]
+ */
+
+/**
+ * @brief Returns the shortest time of several runs of a function in milliseconds.
+ */
+template <typename Function>
+double bestTime(int repetitions, Function function)
+{
+    double best = 0.0;
+    for (int i = 0; i < repetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+/**
+ * @brief Measures building the score matrices against scoring every pair row by row.
+ */
+void benchmarkScoreMatrix(int repetitions)
+{
+    std::cout << "ScoreMatrix build (" << workerCount() << " threads)\n"
+              << "level   codes  matrix bytes   blocked ms  packed bytes    packed ms   row-by-row ms\n";
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        std::size_t bytes = 0;
+        double blocked = bestTime(repetitions, [&]()
+        {
+            ScoreMatrix matrix(level);
+            bytes = matrix.bytes();
+        });
+        std::size_t packedBytes = 0;
+        double packed = bestTime(repetitions, [&]()
+        {
+            PackedScoreMatrix matrix(level);
+            packedBytes = matrix.bytes();
+        });
+        std::vector<std::uint8_t> cells;
+        double rowByRow = bestTime(repetitions, [&]()
+        {
+            CombinationList codes = generateAllCombinations(level);
+            cells.assign(codes.size() * codes.size(), 0);
+            for (std::size_t i = 0; i < codes.size(); i++)
+            {
+                for (std::size_t j = 0; j < codes.size(); j++)
+                {
+                    cells[i * codes.size() + j] = outcomeIndex(calculateScore(codes[i], codes[j]));
+                }
+            }
+        });
+
+        std::cout << std::setw(5) << level << std::setw(8) << generateAllCombinations(level).size()
+                  << std::setw(14) << bytes << std::fixed << std::setprecision(2) << std::setw(13) << blocked
+                  << std::setw(14) << packedBytes << std::setw(13) << packed << std::setw(16) << rowByRow << "\n";
+    }
+}
+
+/**
+ * @brief Measures looking scores up in the byte and the packed score matrix.
+ *
+ * Random lookups read single entries; row scans compute the histogram of
+ * every guess, reading byte rows directly and unpacking packed rows first, a
+ * tile row at a time or one row at a time.
+ */
+void benchmarkScoreLookups(int repetitions)
+{
+    const int level = MAX_LEVEL;
+    ScoreMatrix matrix(level);
+    PackedScoreMatrix packed(level);
+    std::size_t n = matrix.size();
+
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+    std::vector<std::pair<std::size_t, std::size_t>> pairs(1 << 22);
+    for (auto& pair : pairs)
+    {
+        pair = {pick(gen), pick(gen)};
+    }
+
+    // Results are stored to a volatile so that the loops are not optimized away
+    volatile long long sink = 0;
+    double matrixRandom = bestTime(repetitions, [&]()
+    {
+        long long sum = 0;
+        for (const auto& [guess, secret] : pairs)
+        {
+            sum += matrix.outcome(guess, secret);
+        }
+        sink = sum;
+    });
+    double packedRandom = bestTime(repetitions, [&]()
+    {
+        long long sum = 0;
+        for (const auto& [guess, secret] : pairs)
+        {
+            sum += packed.outcome(guess, secret);
+        }
+        sink = sum;
+    });
+
+    double matrixRows = bestTime(repetitions, [&]()
+    {
+        for (std::size_t g = 0; g < n; g++)
+        {
+            OutcomeHistogram histogram{};
+            const std::uint8_t* row = matrix.row(g);
+            for (std::size_t c = 0; c < n; c++)
+            {
+                histogram[row[c]]++;
+            }
+            sink = histogram[0];
+        }
+    });
+    std::vector<std::uint8_t> scratch(PackedScoreMatrix::TILE_SIZE * n);
+    double packedRows = bestTime(repetitions, [&]()
+    {
+        for (std::size_t tileRow = 0; tileRow < packed.tileRows(); tileRow++)
+        {
+            packed.unpackRows(tileRow, scratch.data());
+            std::size_t first = tileRow * PackedScoreMatrix::TILE_SIZE;
+            for (std::size_t g = first; g < std::min(first + PackedScoreMatrix::TILE_SIZE, n); g++)
+            {
+                OutcomeHistogram histogram{};
+                const std::uint8_t* row = &scratch[(g - first) * n];
+                for (std::size_t c = 0; c < n; c++)
+                {
+                    histogram[row[c]]++;
+                }
+                sink = histogram[0];
+            }
+        }
+    });
+    double packedSingleRows = bestTime(repetitions, [&]()
+    {
+        for (std::size_t g = 0; g < n; g++)
+        {
+            OutcomeHistogram histogram{};
+            packed.unpackRow(g, scratch.data());
+            for (std::size_t c = 0; c < n; c++)
+            {
+                histogram[scratch[c]]++;
+            }
+            sink = histogram[0];
+        }
+    });
+
+    std::cout << "\nScore lookups at level " << level << " (" << pairs.size() << " random pairs, " << n
+              << " row scans)\n"
+              << std::fixed << std::setprecision(2)
+              << "                 random ms   row scans ms\n"
+              << "ScoreMatrix    " << std::setw(12) << matrixRandom << std::setw(15) << matrixRows << "\n"
+              << "Packed         " << std::setw(12) << packedRandom << std::setw(15) << packedRows << "\n"
+              << "Packed by row  " << std::setw(12) << "" << std::setw(15) << packedSingleRows << "\n";
+}
+
+/**
+ * @brief Measures publishing the level tables against attaching to them.
+ *
+ * The first process of a level publishes the tables; every further process
+ * only maps the file. Separate tables for every level are compared with views
+ * of the tables of the highest level.
+ */
+void benchmarkLevelTables(int repetitions)
+{
+    char directory[] = "/tmp/digitmind-benchmark-XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        return;
+    }
+
+    std::cout << "\nLevelTables (" << workerCount() << " threads)\n"
+              << "level      file bytes   publish ms    attach ms\n";
+    std::size_t totalBytes = 0;
+    double totalPublish = 0.0;
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        std::string path = std::string(directory) + "/level-" + std::to_string(level) + ".tables";
+        double publish = bestTime(repetitions, [&]()
+        {
+            publishLevelTables(path, level);
+        });
+        std::size_t bytes = 0;
+        double attach = bestTime(repetitions, [&]()
+        {
+            std::optional<LevelTables> tables = LevelTables::open(path, level);
+            bytes = tables ? tables->bytes() : 0;
+        });
+        std::remove(path.c_str());
+
+        std::cout << std::setw(5) << level << std::setw(16) << bytes << std::fixed << std::setprecision(2)
+                  << std::setw(13) << publish << std::setw(13) << attach << "\n";
+        totalBytes += bytes;
+        totalPublish += publish;
+    }
+
+    // All levels as views of the tables of the highest level
+    std::string path = std::string(directory) + "/level-" + std::to_string(MAX_LEVEL) + ".tables";
+    double publish = bestTime(repetitions, [&]()
+    {
+        publishLevelTables(path, MAX_LEVEL);
+    });
+    std::optional<LevelTables> tables = LevelTables::open(path, MAX_LEVEL);
+    std::size_t highestBytes = tables->bytes();
+    std::size_t viewBytes = 0;
+    double views = bestTime(repetitions, [&]()
+    {
+        viewBytes = 0;
+        for (int level = MIN_LEVEL; level < MAX_LEVEL; level++)
+        {
+            LevelView view(*tables, level);
+            viewBytes += view.size() * sizeof(std::uint16_t) + view.members().size() * sizeof(std::uint64_t);
+        }
+    });
+    tables.reset();
+    std::remove(path.c_str());
+    rmdir(directory);
+
+    std::cout << "all levels as separate tables: " << totalBytes << " bytes, " << totalPublish << " ms\n"
+              << "all levels as views of level " << MAX_LEVEL << ": "
+              << highestBytes + viewBytes << " bytes, " << publish + views << " ms\n";
+}
+
+/**
+ * @brief Measures the memory of a candidate set as a compressed set, a plain
+ * bitset and an id list over the moves of random games at the highest level.
+ */
+void benchmarkCompressedSet()
+{
+    const int level = MAX_LEVEL;
+    const int games = 200;
+    const std::size_t moves = 6;
+    CombinationList allCombinations = generateAllCombinations(level);
+    std::size_t words = (allCombinations.size() + 63) / 64;
+
+    std::vector<double> compressedBytes(moves + 1), idBytes(moves + 1);
+    std::vector<int> sets(moves + 1);
+    std::mt19937 gen(1);
+    for (int game = 0; game < games; game++)
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, allCombinations.size() - 1);
+        const DigitCombination& secret = allCombinations[pick(gen)];
+        CompressedSet set = CompressedSet::all(allCombinations.size());
+        for (std::size_t move = 0; move <= moves && set.cardinality() > 0; move++)
+        {
+            compressedBytes[move] += set.bytes();
+            idBytes[move] += set.cardinality() * sizeof(std::uint16_t);
+            sets[move]++;
+
+            // Guess a random candidate and keep the candidates giving its score
+            std::vector<std::uint16_t> ids = set.ids();
+            std::uniform_int_distribution<std::size_t> pickCandidate(0, ids.size() - 1);
+            const DigitCombination& guess = allCombinations[ids[pickCandidate(gen)]];
+            Score score = calculateScore(guess, secret);
+            std::vector<std::uint64_t> partition(words);
+            for (std::size_t id = 0; id < allCombinations.size(); id++)
+            {
+                if (calculateScore(guess, allCombinations[id]) == score)
+                {
+                    partition[id / 64] |= std::uint64_t{1} << (id % 64);
+                }
+            }
+            set = set.intersect(partition.data());
+        }
+    }
+
+    std::cout << "\nCandidate set memory at level " << level << " (average over " << games << " random games)\n"
+              << "move   compressed bytes   bitset bytes   id list bytes\n";
+    for (std::size_t move = 0; move <= moves && sets[move] > 0; move++)
+    {
+        std::cout << std::setw(4) << move << std::fixed << std::setprecision(0)
+                  << std::setw(19) << compressedBytes[move] / sets[move]
+                  << std::setw(15) << words * sizeof(std::uint64_t)
+                  << std::setw(16) << idBytes[move] / sets[move] << "\n";
+    }
+}
+
+/**
+ * @brief Returns the average time of a histogram of a store over some guesses in nanoseconds.
+ */
+template <typename Store>
+double histogramTime(int repetitions, const Store& store, const CombinationList& guesses)
+{
+    volatile int sink = 0;
+    double elapsed = bestTime(repetitions, [&]()
+    {
+        for (const DigitCombination& guess : guesses)
+        {
+            sink = store.histogram(guess)[0];
+        }
+    });
+    return elapsed * 1e6 / guesses.size();
+}
+
+/**
+ * @brief Scores every candidate for a guess, as evaluateGuess() does.
+ */
+struct ScoredCandidates
+{
+    CombinationList candidates;
+
+    OutcomeHistogram histogram(const DigitCombination& guess) const
+    {
+        OutcomeHistogram histogram{};
+        for (const DigitCombination& code : candidates)
+        {
+            histogram[outcomeIndex(calculateScore(guess, code))]++;
+        }
+        return histogram;
+    }
+};
+
+/**
+ * @brief Measures the histogram of every candidate representation over
+ * shrinking random candidate sets at every level, to find the sizes at which
+ * another representation becomes the fastest. These crossover points are the
+ * defaults of CandidateSetOptions.
+ */
+void benchmarkCandidateStores(int repetitions)
+{
+    std::cout << "\nHistogram per guess in ns by candidate count\n"
+              << "level  candidates     scored  bitsliced        soa   inverted   adaptive\n";
+    std::mt19937 gen(1);
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        CombinationList allCombinations = generateAllCombinations(level);
+        CombinationList guesses = allCombinations;
+        std::shuffle(guesses.begin(), guesses.end(), gen);
+        guesses.resize(std::min<std::size_t>(guesses.size(), 256));
+
+        for (std::size_t count = allCombinations.size(); count >= 2; count /= 4)
+        {
+            // A random subset in generation order, like a filtered list
+            CombinationList candidates;
+            std::sample(allCombinations.begin(), allCombinations.end(), std::back_inserter(candidates), count, gen);
+
+            std::cout << std::setw(5) << level << std::setw(12) << count << std::fixed << std::setprecision(0)
+                      << std::setw(11) << histogramTime(repetitions, ScoredCandidates{candidates}, guesses)
+                      << std::setw(11) << histogramTime(repetitions, BitSlicedCandidates(candidates), guesses)
+                      << std::setw(11) << histogramTime(repetitions, SoACandidates(candidates), guesses)
+                      << std::setw(11) << histogramTime(repetitions, InvertedIndex(candidates), guesses)
+                      << std::setw(11) << histogramTime(repetitions, CandidateSet(candidates), guesses) << "\n";
+        }
+    }
+}
+
+/**
+ * @brief Measures filtering all combinations of the highest level by a
+ * history, compiled against scoring every candidate for every move.
+ */
+void benchmarkFilterByHistory(int repetitions)
+{
+    const int level = MAX_LEVEL;
+    CombinationList allCombinations = generateAllCombinations(level);
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<std::size_t> pick(0, allCombinations.size() - 1);
+
+    std::cout << "\nFiltering all combinations at level " << level << " by a history in us\n"
+              << "moves     scored   compiled\n";
+    for (std::size_t moves : {1, 2, 4, 8, 16})
+    {
+        // Random guesses scored against a random secret
+        const DigitCombination& secret = allCombinations[pick(gen)];
+        GameHistory history;
+        for (std::size_t move = 0; move < moves; move++)
+        {
+            const DigitCombination& guess = allCombinations[pick(gen)];
+            history.push_back(Move{guess, calculateScore(guess, secret)});
+        }
+
+        volatile std::size_t sink = 0;
+        double scored = bestTime(repetitions, [&]()
+        {
+            CombinationList consistent;
+            for (const DigitCombination& code : allCombinations)
+            {
+                bool matches = true;
+                for (const Move& move : history)
+                {
+                    matches = matches && calculateScore(move.guess, code) == move.score;
+                }
+                if (matches)
+                {
+                    consistent.push_back(code);
+                }
+            }
+            sink = consistent.size();
+        });
+        double compiled = bestTime(repetitions, [&]()
+        {
+            sink = filterByHistory(allCombinations, history).size();
+        });
+
+        std::cout << std::setw(5) << moves << std::fixed << std::setprecision(0)
+                  << std::setw(11) << scored * 1000 << std::setw(11) << compiled * 1000 << "\n";
+    }
+}
+
+/**
+ * @brief Measures the rejection rate of every stage of the filter pipeline and
+ * its speed against scoring every candidate, over random games at every level.
+ */
+void benchmarkFilterPipeline(int repetitions)
+{
+    std::cout << "\nFilter pipeline over random games (rejected share of examined candidates)\n"
+              << "level    examined     shared      right   accepted   scored us   pipeline us\n";
+    std::mt19937 gen(1);
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        CombinationList allCombinations = generateAllCombinations(level);
+        std::uniform_int_distribution<std::size_t> pick(0, allCombinations.size() - 1);
+
+        // Random guesses filtering down to a random secret; the filters are timed on all combinations
+        FilterPipeline::Statistics total;
+        double scored = 0.0;
+        double piped = 0.0;
+        for (int game = 0; game < 20; game++)
+        {
+            const DigitCombination& secret = allCombinations[pick(gen)];
+            CombinationList candidates = allCombinations;
+            while (candidates.size() > 1)
+            {
+                const DigitCombination& guess = allCombinations[pick(gen)];
+                Score score = calculateScore(guess, secret);
+
+                scored += bestTime(repetitions, [&]()
+                {
+                    CombinationList filtered = candidates;
+                    std::erase_if(filtered, [&](const DigitCombination& code)
+                    {
+                        return !(calculateScore(guess, code) == score);
+                    });
+                });
+                piped += bestTime(repetitions, [&]()
+                {
+                    CombinationList filtered = candidates;
+                    FilterPipeline(guess, score).filter(filtered);
+                });
+
+                FilterPipeline pipeline(guess, score);
+                pipeline.filter(candidates);
+                total.examined += pipeline.statistics().examined;
+                total.rejectedShared += pipeline.statistics().rejectedShared;
+                total.rejectedRight += pipeline.statistics().rejectedRight;
+            }
+        }
+
+        double examined = static_cast<double>(total.examined);
+        std::size_t accepted = total.examined - total.rejectedShared - total.rejectedRight;
+        std::cout << std::setw(5) << level << std::setw(12) << total.examined << std::fixed << std::setprecision(3)
+                  << std::setw(11) << total.rejectedShared / examined << std::setw(11)
+                  << total.rejectedRight / examined << std::setw(11) << accepted / examined
+                  << std::setprecision(0) << std::setw(12) << scored * 1000 << std::setw(14) << piped * 1000
+                  << "\n";
+    }
+}
+
+/**
+ * @brief Measures analyzing batches of random games, played by guessing a random candidate.
+ *
+ * The first batch of a level also fills the shared caches of the best guesses;
+ * the later ones show the rate once the common states have been searched.
+ */
+void benchmarkGameAnalysis(int repetitions)
+{
+    std::cout << "\nGame analysis of 1000 games guessing random candidates\n"
+              << "level   moves   first ms   cached ms   games/s\n";
+    std::mt19937 gen(1);
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        CombinationList allCombinations = generateAllCombinations(level);
+        std::uniform_int_distribution<std::size_t> pick(0, allCombinations.size() - 1);
+
+        std::vector<GameHistory> games(1000);
+        std::size_t moves = 0;
+        for (GameHistory& game : games)
+        {
+            const DigitCombination& secret = allCombinations[pick(gen)];
+            CombinationList candidates = allCombinations;
+            Score score;
+            do
+            {
+                std::uniform_int_distribution<std::size_t> pickCandidate(0, candidates.size() - 1);
+                DigitCombination guess = candidates[pickCandidate(gen)];
+                score = calculateScore(guess, secret);
+                game.push_back(Move{guess, score});
+                filterCombinations(candidates, guess, score);
+            } while (score.right_position < 4);
+            moves += game.size();
+        }
+
+        volatile std::size_t sink = 0;
+        double first = bestTime(1, [&]()
+        {
+            sink = sink + analyzeGames(level, games).size();
+        });
+        double cached = bestTime(repetitions, [&]()
+        {
+            sink = sink + analyzeGames(level, games).size();
+        });
+        std::cout << std::setw(5) << level << std::setw(8) << moves << std::fixed << std::setprecision(1)
+                  << std::setw(11) << first << std::setw(12) << cached << std::setprecision(0)
+                  << std::setw(10) << games.size() / cached * 1000 << "\n";
+    }
+}
+
+/**
+ * @brief Measures weighted histograms under the human prior against
+ * unweighted ones, and the number of guesses the Bayesian strategy saves
+ * against the entropy strategy when secrets follow the prior.
+ *
+ * The ratio is the time of the representation the Bayesian strategy picks
+ * for the set over the unweighted time.
+ */
+void benchmarkWeightedHistograms(int repetitions)
+{
+    std::cout << "\nHistogram per guess in ns, unweighted and under the human prior in weight classes and\n"
+              << "with packed counts, the ratio of the weighted to the unweighted time, and guesses expected\n"
+              << "level  candidates  unweighted    classes     packed  ratio    entropy   bayesian\n";
+    std::mt19937 gen(1);
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        const SecretPrior& prior = humanPrior(level);
+        CombinationList allCombinations = generateAllCombinations(level);
+        CombinationList guesses = allCombinations;
+        std::shuffle(guesses.begin(), guesses.end(), gen);
+        guesses.resize(std::min<std::size_t>(guesses.size(), 256));
+
+        // The expected number of guesses when the secret is drawn from the prior
+        double expected[2] = {0.0, 0.0};
+        Strategy strategies[2] = {Strategy::Entropy, Strategy::Bayesian};
+        for (int s = 0; s < 2; s++)
+        {
+            std::vector<std::uint8_t> counts = measureGuessCounts(strategies[s], level);
+            double total = 0.0;
+            for (std::size_t i = 0; i < counts.size(); i++)
+            {
+                expected[s] += prior.weight(i) * counts[i];
+                total += prior.weight(i);
+            }
+            expected[s] /= total;
+        }
+
+        for (std::size_t count = allCombinations.size(); count >= 16; count /= 4)
+        {
+            CombinationList candidates;
+            std::sample(allCombinations.begin(), allCombinations.end(), std::back_inserter(candidates), count, gen);
+            CandidateSet unweighted(candidates);
+            WeightedCandidates classes(candidates, prior, 0);
+            WeightedCandidates packed(candidates, prior, candidates.size() + 1);
+            bool picksPacked = WeightedCandidates(candidates, prior).usesPackedCounts();
+
+            volatile double sink = 0.0;
+            double unweightedTime = bestTime(repetitions, [&]()
+            {
+                for (const DigitCombination& guess : guesses)
+                {
+                    sink = unweighted.histogram(guess)[0];
+                }
+            });
+            double classesTime = bestTime(repetitions, [&]()
+            {
+                for (const DigitCombination& guess : guesses)
+                {
+                    sink = classes.histogram(guess).weights[0];
+                }
+            });
+            std::cout << std::setw(5) << level << std::setw(12) << count << std::fixed << std::setprecision(0)
+                      << std::setw(12) << unweightedTime * 1e6 / guesses.size() << std::setw(11)
+                      << classesTime * 1e6 / guesses.size();
+
+            // Packed counts hold too few candidates for the larger sets
+            double weightedTime = classesTime;
+            if (packed.usesPackedCounts())
+            {
+                double packedTime = bestTime(repetitions, [&]()
+                {
+                    for (const DigitCombination& guess : guesses)
+                    {
+                        sink = packed.histogram(guess).weights[0];
+                    }
+                });
+                std::cout << std::setw(11) << packedTime * 1e6 / guesses.size();
+                weightedTime = picksPacked ? packedTime : classesTime;
+            }
+            else
+            {
+                std::cout << std::setw(11) << "-";
+            }
+            std::cout << std::setprecision(2) << std::setw(7) << weightedTime / unweightedTime;
+            std::cout << std::setprecision(3);
+            if (count == allCombinations.size())
+            {
+                std::cout << std::setw(11) << expected[0] << std::setw(11) << expected[1];
+            }
+            std::cout << std::defaultfloat << "\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int repetitions = argc > 1 ? std::max(1, std::atoi(argv[1])) : 3;
+
+    benchmarkScoreMatrix(repetitions);
+    benchmarkScoreLookups(repetitions);
+    benchmarkLevelTables(repetitions);
+    benchmarkCompressedSet();
+    benchmarkCandidateStores(repetitions);
+    benchmarkFilterByHistory(repetitions);
+    benchmarkFilterPipeline(repetitions);
+    benchmarkGameAnalysis(repetitions);
+    benchmarkWeightedHistograms(repetitions);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "digitmind.h"
+#include "level_tables.h"
+#include "parallel.h"
+#include "puzzle.h"
+
+/**
+ * Generator of deduction puzzles.
+ *
+ * Every puzzle is a list of guesses with their scores (right, wrong) that
+ * leaves exactly one combination, followed by that solution. No clue can be
+ * left out without the solution becoming ambiguous. Puzzles are generated in
+ * parallel, puzzle i from seed + i, so the output is reproducible.
+ *
+ * Usage: DigitMindPuzzle <level> [count] [clues] [max right] [seed]
+ *
+ * The clues are a number or a range such as 4-6; max right limits the right
+ * positions of every clue (at most 3, so the solution is never a clue). The
+ * tables of level 10, which serve every level, are mapped from the directory
+ * given by the DIGITMIND_CACHE_DIR environment variable and published there
+ * when missing.
+ */
+
+/**
+ * @brief Formats a puzzle as one line: the clues, then the solution.
+ */
+std::string formatPuzzle(const Puzzle& puzzle)
+{
+    auto toString = [](const DigitCombination& combination)
+    {
+        std::string text;
+        for (int digit : combination)
+        {
+            text += static_cast<char>('0' + digit);
+        }
+        return text;
+    };
+
+    std::ostringstream line;
+    for (const Move& clue : puzzle.clues)
+    {
+        line << toString(clue.guess) << " " << clue.score.right_position << "," << clue.score.wrong_position
+             << "  ";
+    }
+    line << "= " << toString(puzzle.solution);
+    return line.str();
+}
+
+int main(int argc, char* argv[])
+{
+    int level = argc > 1 ? std::atoi(argv[1]) : 0;
+    if (level < MIN_LEVEL || level > MAX_LEVEL)
+    {
+        std::cerr << "Usage: DigitMindPuzzle <level> [count] [clues] [max right] [seed]\n";
+        return 2;
+    }
+    std::size_t count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+    PuzzleOptions options;
+    if (argc > 3)
+    {
+        char* end;
+        options.minClues = options.maxClues = std::strtoul(argv[3], &end, 10);
+        if (*end == '-')
+        {
+            options.maxClues = std::strtoul(end + 1, nullptr, 10);
+        }
+    }
+    if (argc > 4)
+    {
+        options.maxRightPosition = std::atoi(argv[4]);
+    }
+    unsigned seed = argc > 5 ? static_cast<unsigned>(std::strtoul(argv[5], nullptr, 10)) : std::random_device()();
+    if (options.minClues < 1 || options.maxClues < options.minClues || options.maxRightPosition < 0
+        || options.maxRightPosition > 3)
+    {
+        std::cerr << "The clues must be a non-empty range and max right between 0 and 3\n";
+        return 2;
+    }
+
+    std::optional<LevelView> view = attachLevelView(level);
+    if (!view)
+    {
+        std::cerr << "Could not map " << levelTablesPath(10) << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    PuzzleGenerator generator(*view, options);
+    std::vector<std::optional<Puzzle>> puzzles(count);
+    parallelFor(count, [&](std::size_t i)
+    {
+        std::mt19937 gen(seed + static_cast<unsigned>(i));
+        puzzles[i] = generator.generate(gen);
+    }, 16);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::size_t generated = 0;
+    for (const std::optional<Puzzle>& puzzle : puzzles)
+    {
+        if (puzzle)
+        {
+            std::cout << formatPuzzle(*puzzle) << "\n";
+            generated++;
+        }
+    }
+    std::cerr << generated << " of " << count << " puzzles generated in " << elapsed.count() << " s ("
+              << static_cast<long long>(generated / elapsed.count() * 60) << " per minute, seed " << seed << ")\n";
+    return generated == count ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "canonical.h"
+#include "digitmind.h"
+#include "parallel.h"
+#include "secret_difficulty.h"
+#include "solution_store.h"
+#include "strategy.h"
+#include "transposition_table.h"
+
+/**
+ * Batch solver for the DigitMind strategies.
+ *
+ * The solver plays the strategy against every secret code at once by walking
+ * the game tree: the best guess for a state partitions its candidates by
+ * score, and every partition that does not contain the winning score is the
+ * next state. All states that were searched are written in canonical form to
+ * the solution store of the strategy and level, where the online guess
+ * selection finds them.
+ *
+ * Usage: DigitMindSolve <minimax|entropy|lookahead> [level]
+ *
+ * Without a level, all levels from 4 to 10 are solved. The store is written
+ * to the directory given by the DIGITMIND_CACHE_DIR environment variable,
+ * together with the difficulty table of the number of guesses per secret.
+ */
+
+struct SolveResult
+{
+    std::vector<StoredSolution> solutions;
+    long long totalGuesses = 0;
+    int maxGuesses = 0;
+
+    void merge(const SolveResult& other)
+    {
+        solutions.insert(solutions.end(), other.solutions.begin(), other.solutions.end());
+        totalGuesses += other.totalGuesses;
+        maxGuesses = std::max(maxGuesses, other.maxGuesses);
+    }
+};
+
+/**
+ * @brief Partitions candidates by the score they give for a guess.
+ */
+std::array<CombinationList, NUM_OUTCOMES> partition(const DigitCombination& guess,
+                                                    const CombinationList& candidates)
+{
+    std::array<CombinationList, NUM_OUTCOMES> buckets;
+    for (const DigitCombination& code : candidates)
+    {
+        buckets[outcomeIndex(calculateScore(guess, code))].push_back(code);
+    }
+    return buckets;
+}
+
+/**
+ * @brief Solves a state in canonical form and records it.
+ *
+ * @return The best guess in the labeling of the state.
+ */
+DigitCombination solveCanonical(Strategy strategy, int level, const GameHistory& history,
+                                const CombinationList& candidates, SolveResult& result)
+{
+    CanonicalState canonical = canonicalize(level, history, candidates);
+    GuessEvaluation best = findBestGuess(strategy, level, canonical.candidates);
+
+    // States of one or two candidates are answered without searching, and a
+    // search cut short by its time budget would store a machine-dependent guess
+    if (candidates.size() > 2 && best.isComplete)
+    {
+        result.solutions.push_back(makeStoredSolution(hashCandidateSet(canonical.candidates), best));
+    }
+    return canonical.symmetry.invert(best.guess);
+}
+
+/**
+ * @brief Solves a state and, recursively, all states following it.
+ */
+void solveState(Strategy strategy, int level, GameHistory& history, const CombinationList& candidates,
+                SolveResult& result)
+{
+    DigitCombination guess = solveCanonical(strategy, level, history, candidates, result);
+
+    // The guess made in this state is guess number depth
+    int depth = static_cast<int>(history.size()) + 1;
+    auto buckets = partition(guess, candidates);
+    if (!buckets[NUM_OUTCOMES - 1].empty())
+    {
+        result.totalGuesses += depth;
+        result.maxGuesses = std::max(result.maxGuesses, depth);
+    }
+    for (int i = 0; i < NUM_OUTCOMES - 1; i++)
+    {
+        if (!buckets[i].empty())
+        {
+            history.push_back(Move{guess, outcomeScore(i)});
+            solveState(strategy, level, history, buckets[i], result);
+            history.pop_back();
+        }
+    }
+}
+
+/**
+ * @brief Solves all states of a level and writes them to the solution store.
+ */
+bool solveLevel(Strategy strategy, int level)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // Solve the first move here and the subtrees of its scores in parallel
+    CombinationList allCombinations = generateAllCombinations(level);
+    SolveResult total;
+    DigitCombination first = solveCanonical(strategy, level, GameHistory(), allCombinations, total);
+    total.totalGuesses = 1;
+    total.maxGuesses = 1;
+
+    auto buckets = partition(first, allCombinations);
+    std::array<SolveResult, NUM_OUTCOMES> results;
+    parallelFor(NUM_OUTCOMES - 1, [&](std::size_t i)
+    {
+        if (!buckets[i].empty())
+        {
+            GameHistory history = {Move{first, outcomeScore(static_cast<int>(i))}};
+            solveState(strategy, level, history, buckets[i], results[i]);
+        }
+    });
+    for (const SolveResult& result : results)
+    {
+        total.merge(result);
+    }
+
+    // Keep the solutions of an existing store that were not reached now
+    std::size_t reached = total.solutions.size();
+    std::string path = solutionStorePath(strategy, level);
+    if (auto existing = SolutionStore::open(path, strategy, level))
+    {
+        std::vector<StoredSolution> solutions = existing->solutions();
+        total.solutions.insert(total.solutions.end(), solutions.begin(), solutions.end());
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << strategyName(strategy) << " level " << level << ": "
+              << "average " << static_cast<double>(total.totalGuesses) / allCombinations.size()
+              << " guesses, worst case " << total.maxGuesses << " guesses, "
+              << reached << " states solved in " << elapsed.count() << " s\n";
+
+    if (!writeSolutionStore(path, strategy, level, total.solutions))
+    {
+        std::cerr << "Could not write " << path << "\n";
+        return false;
+    }
+    std::cout << "Written to " << path << "\n";
+
+    // Measure the guesses of every secret from the states just solved
+    DifficultyTable difficulty(strategy, level, measureGuessCounts(strategy, level));
+    std::string difficultyPath = difficultyTablePath(strategy, level);
+    if (!difficulty.write(difficultyPath))
+    {
+        std::cerr << "Could not write " << difficultyPath << "\n";
+        return false;
+    }
+    std::cout << "Written to " << difficultyPath << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    std::optional<Strategy> strategy = argc > 1 ? parseStrategy(argv[1]) : std::nullopt;
+    // The Bayesian strategy cannot share canonical states, see findBestGuess()
+    if (!strategy || *strategy == Strategy::Random || *strategy == Strategy::Bayesian)
+    {
+        std::cerr << "Usage: DigitMindSolve <minimax|entropy|lookahead> [level]\n";
+        return 2;
+    }
+
+    int firstLevel = MIN_LEVEL;
+    int lastLevel = MAX_LEVEL;
+    if (argc > 2)
+    {
+        firstLevel = lastLevel = std::atoi(argv[2]);
+        if (firstLevel < MIN_LEVEL || firstLevel > MAX_LEVEL)
+        {
+            std::cerr << "The level must be between 4 and 10\n";
+            return 2;
+        }
+    }
+
+    bool success = true;
+    for (int level = firstLevel; level <= lastLevel; level++)
+    {
+        success = solveLevel(*strategy, level) && success;
+    }
+    return success ? 0 : 1;
+}
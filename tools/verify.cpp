@@ -0,0 +1,1899 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "alias_table.h"
+#include "bayesian.h"
+#include "bitsliced.h"
+#include "candidate_set.h"
+#include "canonical.h"
+#include "compiled_history.h"
+#include "compressed_set.h"
+#include "digitmind.h"
+#include "filter_pipeline.h"
+#include "game_analysis.h"
+#include "inverted_index.h"
+#include "level_cache.h"
+#include "level_tables.h"
+#include "lookahead.h"
+#include "outcome_partition.h"
+#include "parallel.h"
+#include "partition_histograms.h"
+#include "puzzle.h"
+#include "score_matrix.h"
+#include "secret_difficulty.h"
+#include "secret_prior.h"
+#include "solution_store.h"
+#include "soa_candidates.h"
+#include "strategy.h"
+#include "transposition_table.h"
+#include "weighted_candidates.h"
+
+/**
+ * Differential verification of the DigitMind kernels.
+ *
+ * Every optimized kernel is compared against the reference implementations
+ * below, which are frozen copies of the original, straightforward versions of
+ * calculateScore(), generateAllCombinations(), filterCombinations() and the
+ * exhaustive guess search. The
+ * scoring kernels are checked exhaustively for all code pairs at every level,
+ * the filter kernels are checked over randomized game histories.
+ *
+ * Usage: DigitMindVerify [histories per level] [seed]
+ *
+ * The exit code is non-zero when any kernel diverges from the reference.
+ */
+
+namespace reference
+{
+
+Score calculateScore(DigitCombination guess, DigitCombination code)
+{
+    Score score;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (guess[i] == code[i])
+        {
+            score.right_position++;
+        }
+        else
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                if (guess[i] == code[j])
+                {
+                    score.wrong_position++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return score;
+}
+
+CombinationList generateAllCombinations(int level)
+{
+    CombinationList allCombinations;
+
+    for (int i = 0; i < level; i++)
+    {
+        for (int j = 0; j < level; j++)
+        {
+            for (int k = 0; k < level; k++)
+            {
+                for (int l = 0; l < level; l++)
+                {
+                    if (i != j && i != k && i != l && j != k && j != l && k != l)
+                    {
+                        allCombinations.push_back(DigitCombination{i, j, k, l});
+                    }
+                }
+            }
+        }
+    }
+    return allCombinations;
+}
+
+void filterCombinations(CombinationList& allCombinations,
+                        const DigitCombination& guess,
+                        const Score& score)
+{
+    auto it = allCombinations.begin();
+    while (it != allCombinations.end())
+    {
+        if (calculateScore(guess, *it) == score)
+        {
+            ++it;
+            continue;
+        }
+        it = allCombinations.erase(it);
+    }
+}
+
+GuessEvaluation searchBestGuess(Strategy strategy, int level, const CombinationList& candidates)
+{
+    if (candidates.size() <= 2)
+    {
+        return evaluateGuess(candidates.front(), candidates);
+    }
+
+    GuessEvaluation best;
+    bool found = false;
+    for (const DigitCombination& guess : generateAllCombinations(level))
+    {
+        GuessEvaluation evaluation = evaluateGuess(guess, candidates);
+        if (!found || isBetterGuess(strategy, evaluation, best))
+        {
+            best = evaluation;
+            found = true;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Returns the expected number of combinations remaining after the best
+ * next guess, trying every guess of the level.
+ */
+double bestFollowUp(int level, const CombinationList& bucket)
+{
+    double best = static_cast<double>(bucket.size());
+    for (const DigitCombination& guess : generateAllCombinations(level))
+    {
+        OutcomeHistogram histogram{};
+        for (const DigitCombination& code : bucket)
+        {
+            histogram[outcomeIndex(calculateScore(guess, code))]++;
+        }
+        double expected = 0.0;
+        for (int outcome = 0; outcome < NUM_OUTCOMES - 1; outcome++)
+        {
+            expected += static_cast<double>(histogram[outcome]) * histogram[outcome] / bucket.size();
+        }
+        best = std::min(best, expected);
+    }
+    return best;
+}
+
+/**
+ * @brief Returns the expected number of combinations remaining after a guess
+ * and the best follow-up guess for its score.
+ */
+double lookaheadValue(int level, const DigitCombination& guess, const CombinationList& candidates)
+{
+    double value = 0.0;
+    for (int outcome = 0; outcome < NUM_OUTCOMES - 1; outcome++)
+    {
+        CombinationList bucket;
+        for (const DigitCombination& code : candidates)
+        {
+            if (outcomeIndex(calculateScore(guess, code)) == outcome)
+            {
+                bucket.push_back(code);
+            }
+        }
+        if (!bucket.empty())
+        {
+            value += bucket.size() * bestFollowUp(level, bucket) / candidates.size();
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Looks ahead two guesses from the best `breadth` guesses for one step.
+ *
+ * Of the guesses that differ only by digits that are interchangeable in the
+ * candidates, only the first in generation order is ranked. Two digits are
+ * interchangeable when swapping them in every candidate gives the same set.
+ */
+GuessEvaluation searchLookahead(int level, const CombinationList& candidates, std::size_t breadth)
+{
+    if (candidates.size() <= 2)
+    {
+        return evaluateGuess(candidates.front(), candidates);
+    }
+
+    std::array<int, 10> digitClass;
+    std::iota(digitClass.begin(), digitClass.end(), 0);
+    for (int d = 0; d < level; d++)
+    {
+        for (int e = 0; e < d && digitClass[d] == d; e++)
+        {
+            CombinationList swapped;
+            for (DigitCombination code : candidates)
+            {
+                for (int& digit : code)
+                {
+                    digit = digit == d ? e : digit == e ? d : digit;
+                }
+                swapped.push_back(code);
+            }
+            std::sort(swapped.begin(), swapped.end());
+            if (swapped == candidates)
+            {
+                digitClass[d] = digitClass[e];
+            }
+        }
+    }
+
+    std::vector<GuessEvaluation> ranking;
+    std::vector<std::array<int, 4>> signatures;
+    for (const DigitCombination& guess : generateAllCombinations(level))
+    {
+        std::array<int, 4> signature;
+        for (int p = 0; p < 4; p++)
+        {
+            signature[p] = digitClass[guess[p]];
+        }
+        if (std::find(signatures.begin(), signatures.end(), signature) == signatures.end())
+        {
+            signatures.push_back(signature);
+            ranking.push_back(evaluateGuess(guess, candidates));
+        }
+    }
+    std::stable_sort(ranking.begin(), ranking.end(), [](const GuessEvaluation& a, const GuessEvaluation& b)
+    {
+        return isBetterGuess(Strategy::Lookahead, a, b);
+    });
+    ranking.resize(std::min(breadth, ranking.size()));
+
+    std::size_t best = 0;
+    double bestValue = 0.0;
+    for (std::size_t i = 0; i < ranking.size(); i++)
+    {
+        double value = lookaheadValue(level, ranking[i].guess, candidates);
+        if (i == 0 || value < bestValue - 1e-9)
+        {
+            best = i;
+            bestValue = value;
+        }
+    }
+    return ranking[best];
+}
+
+} // namespace reference
+
+std::string toString(const DigitCombination& combination)
+{
+    std::string text;
+    for (int digit : combination)
+    {
+        text += static_cast<char>('0' + digit);
+    }
+    return text;
+}
+
+std::string toString(const Score& score)
+{
+    return "(" + std::to_string(score.right_position) + "," + std::to_string(score.wrong_position) + ")";
+}
+
+/**
+ * @brief Collects the outcome of a single check from any number of threads.
+ */
+class CheckReport
+{
+public:
+    void pass(long long cases = 1)
+    {
+        passed += cases;
+    }
+
+    void fail(const std::string& description)
+    {
+        if (failed++ < MAX_REPORTED)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            descriptions.push_back(description);
+        }
+    }
+
+    bool expect(bool condition, const std::function<std::string()>& describe)
+    {
+        if (condition)
+        {
+            pass();
+        }
+        else
+        {
+            fail(describe());
+        }
+        return condition;
+    }
+
+    long long cases() const { return passed + failed; }
+    long long failures() const { return failed; }
+    const std::vector<std::string>& failureDescriptions() const { return descriptions; }
+
+private:
+    static const int MAX_REPORTED = 5;
+
+    std::atomic<long long> passed{0};
+    std::atomic<long long> failed{0};
+    std::mutex mutex;
+    std::vector<std::string> descriptions;
+};
+
+/**
+ * @brief A game history: the guesses made and the scores they received.
+ */
+struct History
+{
+    DigitCombination secret;
+    GameHistory moves;
+};
+
+/**
+ * @brief Creates a random, consistent game history.
+ *
+ * Guesses are drawn from all codes or, half of the time, from the codes that
+ * are still possible so that the histories also reach the small candidate
+ * sets of the end game.
+ */
+History randomHistory(const CombinationList& allCombinations, std::mt19937& gen)
+{
+    std::uniform_int_distribution<std::size_t> pick(0, allCombinations.size() - 1);
+    std::bernoulli_distribution fromCandidates(0.5);
+
+    History history;
+    history.secret = allCombinations[pick(gen)];
+
+    CombinationList candidates = allCombinations;
+    while (history.moves.size() < 8)
+    {
+        DigitCombination guess = allCombinations[pick(gen)];
+        if (fromCandidates(gen))
+        {
+            std::uniform_int_distribution<std::size_t> pickCandidate(0, candidates.size() - 1);
+            guess = candidates[pickCandidate(gen)];
+        }
+
+        Score score = reference::calculateScore(guess, history.secret);
+        if (score.right_position == 4)
+        {
+            break;
+        }
+        history.moves.push_back(Move{guess, score});
+        reference::filterCombinations(candidates, guess, score);
+    }
+    return history;
+}
+
+struct VerifyOptions
+{
+    int historiesPerLevel = 200;
+    unsigned seed = 20240101;
+};
+
+/**
+ * @brief Runs a check for every random history at every level.
+ *
+ * The histories are generated up front from a per-level seed, so a failure
+ * can be reproduced by running the tool with the same seed. Expensive checks
+ * can use only a fraction of the histories.
+ */
+void forEachHistory(const VerifyOptions& options,
+                    const std::function<void(int, const CombinationList&, const History&)>& check,
+                    int fraction = 1)
+{
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        CombinationList allCombinations = reference::generateAllCombinations(level);
+
+        std::mt19937 gen(options.seed + level);
+        std::vector<History> histories;
+        for (int i = 0; i < options.historiesPerLevel; i++)
+        {
+            histories.push_back(randomHistory(allCombinations, gen));
+        }
+        histories.resize(std::max<std::size_t>(1, histories.size() / fraction));
+
+        parallelFor(histories.size(), [&](std::size_t i)
+        {
+            check(level, allCombinations, histories[i]);
+        });
+    }
+}
+
+void checkGenerateAllCombinations(CheckReport& report, const VerifyOptions&)
+{
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        report.expect(generateAllCombinations(level) == reference::generateAllCombinations(level), [&]()
+        {
+            return "generateAllCombinations(" + std::to_string(level) + ") differs";
+        });
+
+        // Exactly the generated combinations are valid, among all 4 digits
+        // below 10 and a few out of range
+        CombinationList allCombinations = reference::generateAllCombinations(level);
+        std::size_t valid = 0;
+        for (int code = 0; code < 10000; code++)
+        {
+            DigitCombination combination{code / 1000, code / 100 % 10, code / 10 % 10, code % 10};
+            valid += isValidCombination(combination, level);
+        }
+        bool rejectsOutOfRange = !isValidCombination({-1, 0, 1, 2}, level) && !isValidCombination({0, 1, 2, 10}, level)
+                                 && !isValidCombination({0, 1, 2, level}, level);
+        bool acceptsGenerated = std::all_of(allCombinations.begin(), allCombinations.end(),
+                                            [&](const DigitCombination& combination)
+        {
+            return isValidCombination(combination, level);
+        });
+        report.expect(valid == allCombinations.size() && acceptsGenerated && rejectsOutOfRange, [&]()
+        {
+            return "isValidCombination accepts " + std::to_string(valid) + " combinations at level "
+                   + std::to_string(level) + ", expected " + std::to_string(allCombinations.size());
+        });
+    }
+}
+
+void checkCalculateScore(CheckReport& report, const VerifyOptions&)
+{
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        CombinationList allCombinations = reference::generateAllCombinations(level);
+        parallelFor(allCombinations.size(), [&](std::size_t g)
+        {
+            const DigitCombination& guess = allCombinations[g];
+            long long matches = 0;
+            for (const DigitCombination& code : allCombinations)
+            {
+                Score expected = reference::calculateScore(guess, code);
+                Score actual = calculateScore(guess, code);
+                if (actual == expected)
+                {
+                    matches++;
+                    continue;
+                }
+                report.fail("level " + std::to_string(level) + ": calculateScore(" + toString(guess) + ", "
+                            + toString(code) + ") = " + toString(actual) + ", expected " + toString(expected));
+            }
+            report.pass(matches);
+        }, 16);
+    }
+}
+
+void checkScoreMatrix(CheckReport& report, const VerifyOptions&)
+{
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        CombinationList allCombinations = reference::generateAllCombinations(level);
+        ScoreMatrix matrix(level);
+        PackedScoreMatrix packed(level);
+        if (!report.expect(matrix.combinations() == allCombinations && packed.combinations() == allCombinations,
+                           [&]()
+            {
+                return "level " + std::to_string(level) + ": combinations differ";
+            }))
+        {
+            continue;
+        }
+
+        parallelFor(allCombinations.size(), [&](std::size_t g)
+        {
+            std::vector<std::uint8_t> unpacked(packed.size());
+            packed.unpackRow(g, unpacked.data());
+
+            long long matches = 0;
+            for (std::size_t c = 0; c < allCombinations.size(); c++)
+            {
+                int expected = outcomeIndex(reference::calculateScore(allCombinations[g], allCombinations[c]));
+                if (matrix.outcome(g, c) == expected && matrix.row(g)[c] == expected
+                    && packed.outcome(g, c) == expected && unpacked[c] == expected)
+                {
+                    matches++;
+                    continue;
+                }
+                report.fail("level " + std::to_string(level) + ": outcome(" + toString(allCombinations[g]) + ", "
+                            + toString(allCombinations[c]) + ") = " + std::to_string(matrix.outcome(g, c))
+                            + " / packed " + std::to_string(packed.outcome(g, c)) + " / unpacked "
+                            + std::to_string(unpacked[c]) + ", expected " + std::to_string(expected));
+            }
+            report.pass(matches);
+        }, 16);
+
+        // Unpacking a tile row gives the rows of all its guesses
+        parallelFor(packed.tileRows(), [&](std::size_t tileRow)
+        {
+            std::size_t n = packed.size();
+            std::vector<std::uint8_t> rows(PackedScoreMatrix::TILE_SIZE * n);
+            packed.unpackRows(tileRow, rows.data());
+            std::size_t first = tileRow * PackedScoreMatrix::TILE_SIZE;
+            for (std::size_t g = first; g < std::min(first + PackedScoreMatrix::TILE_SIZE, n); g++)
+            {
+                report.expect(std::equal(matrix.row(g), matrix.row(g) + n, &rows[(g - first) * n]), [&]()
+                {
+                    return "level " + std::to_string(level) + ": unpacked tile row of "
+                           + toString(allCombinations[g]) + " differs";
+                });
+            }
+        });
+    }
+}
+
+void checkLevelTables(CheckReport& report, const VerifyOptions&)
+{
+    char directory[] = "/tmp/digitmind-verify-XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        report.fail("cannot create a temporary directory");
+        return;
+    }
+
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        std::string path = std::string(directory) + "/level-" + std::to_string(level) + ".tables";
+        std::optional<LevelTables> tables;
+        if (publishLevelTables(path, level))
+        {
+            tables = LevelTables::open(path, level);
+        }
+        bool opened = report.expect(tables.has_value(), [&]()
+        {
+            return "level " + std::to_string(level) + ": tables cannot be published and opened";
+        });
+        report.expect(!LevelTables::open(path, level == MAX_LEVEL ? MIN_LEVEL : level + 1), [&]()
+        {
+            return "level " + std::to_string(level) + ": tables are opened for another level";
+        });
+        if (!opened)
+        {
+            std::remove(path.c_str());
+            continue;
+        }
+
+        CombinationList allCombinations = reference::generateAllCombinations(level);
+        CombinationList mapped(tables->combinations(), tables->combinations() + tables->size());
+        if (report.expect(mapped == allCombinations, [&]()
+            {
+                return "level " + std::to_string(level) + ": combinations differ";
+            }))
+        {
+            parallelFor(allCombinations.size(), [&](std::size_t g)
+            {
+                long long matches = 0;
+                for (std::size_t c = 0; c < allCombinations.size(); c++)
+                {
+                    int expected = outcomeIndex(reference::calculateScore(allCombinations[g], allCombinations[c]));
+                    bool partitioned = true;
+                    for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+                    {
+                        bool bit = (tables->partition(g, outcome)[c / 64] >> (c % 64)) & 1;
+                        partitioned = partitioned && bit == (outcome == expected);
+                    }
+                    if (tables->outcome(g, c) == expected && tables->row(g)[c] == expected && partitioned)
+                    {
+                        matches++;
+                        continue;
+                    }
+                    report.fail("level " + std::to_string(level) + ": tables of (" + toString(allCombinations[g])
+                                + ", " + toString(allCombinations[c]) + ") differ, expected outcome "
+                                + std::to_string(expected));
+                }
+                report.pass(matches);
+            }, 16);
+        }
+        tables.reset();
+        std::remove(path.c_str());
+    }
+    rmdir(directory);
+}
+
+void checkLevelViews(CheckReport& report, const VerifyOptions&)
+{
+    char directory[] = "/tmp/digitmind-verify-XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        report.fail("cannot create a temporary directory");
+        return;
+    }
+
+    std::string path = std::string(directory) + "/level-" + std::to_string(MAX_LEVEL) + ".tables";
+    std::optional<LevelTables> tables;
+    if (publishLevelTables(path, MAX_LEVEL))
+    {
+        tables = LevelTables::open(path, MAX_LEVEL);
+    }
+    if (report.expect(tables.has_value(), [&]() { return std::string("tables cannot be published and opened"); }))
+    {
+        for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+        {
+            LevelView view(*tables, level);
+            CombinationList allCombinations = reference::generateAllCombinations(level);
+            if (!report.expect(view.combinations() == allCombinations, [&]()
+                {
+                    return "level " + std::to_string(level) + ": combinations of the view differ";
+                }))
+            {
+                continue;
+            }
+
+            long long members = 0;
+            for (std::uint64_t word : view.members())
+            {
+                members += std::popcount(word);
+            }
+            bool membersMatch = members == static_cast<long long>(view.size());
+            for (std::size_t i = 0; i < view.size(); i++)
+            {
+                membersMatch = membersMatch && ((view.members()[view.id(i) / 64] >> (view.id(i) % 64)) & 1);
+            }
+            report.expect(membersMatch, [&]()
+            {
+                return "level " + std::to_string(level) + ": members of the view differ";
+            });
+
+            parallelFor(allCombinations.size(), [&](std::size_t g)
+            {
+                long long matches = 0;
+                for (std::size_t c = 0; c < allCombinations.size(); c++)
+                {
+                    int expected = outcomeIndex(reference::calculateScore(allCombinations[g], allCombinations[c]));
+                    if (view.outcome(g, c) == expected)
+                    {
+                        matches++;
+                        continue;
+                    }
+                    report.fail("level " + std::to_string(level) + ": view outcome(" + toString(allCombinations[g])
+                                + ", " + toString(allCombinations[c]) + ") = " + std::to_string(view.outcome(g, c))
+                                + ", expected " + std::to_string(expected));
+                }
+                report.pass(matches);
+            }, 16);
+        }
+    }
+    tables.reset();
+    std::remove(path.c_str());
+    rmdir(directory);
+}
+
+void checkFilterCombinations(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        CombinationList expected = allCombinations;
+        CombinationList actual = allCombinations;
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            const auto& [guess, score] = history.moves[move];
+            reference::filterCombinations(expected, guess, score);
+            filterCombinations(actual, guess, score);
+            if (!report.expect(actual == expected, [&]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                           + ": filterCombinations differs after move " + std::to_string(move + 1)
+                           + " (" + toString(guess) + " " + toString(score) + ")";
+                }))
+            {
+                return;
+            }
+        }
+    });
+}
+
+void checkPartitionHistograms(CheckReport& report, const VerifyOptions& options)
+{
+    // Building the histograms of all codes is the expensive part, so it is done once per level
+    std::array<std::once_flag, MAX_LEVEL + 1> built;
+    std::array<std::optional<PartitionHistograms>, MAX_LEVEL + 1> initial;
+
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        std::call_once(built[level], [&]()
+        {
+            initial[level].emplace(levelData(level));
+            initial[level]->prepare(allCombinations);
+        });
+
+        PartitionHistograms histograms = *initial[level];
+        CombinationList expected = allCombinations;
+        CombinationList actual = allCombinations;
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            const auto& [guess, score] = history.moves[move];
+            reference::filterCombinations(expected, guess, score);
+            histograms.filter(actual, guess, score);
+
+            auto describe = [&](const std::string& problem)
+            {
+                return [&, problem]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                           + ", move " + std::to_string(move + 1) + ": " + problem;
+                };
+            };
+            if (!report.expect(actual == expected, describe("filtered candidates differ"))
+                || !report.expect(histograms.candidateSet().combinations() == expected,
+                                  describe("candidate set differs")))
+            {
+                return;
+            }
+
+            // Compare a sample of the guesses after every move and all after the last
+            bool last = move + 1 == history.moves.size();
+            const CombinationList& guesses = histograms.guesses();
+            for (std::size_t g = move % 13; g < guesses.size(); g += last ? 1 : 13)
+            {
+                OutcomeHistogram recounted{};
+                for (const DigitCombination& code : expected)
+                {
+                    recounted[outcomeIndex(reference::calculateScore(guesses[g], code))]++;
+                }
+                if (!report.expect(histograms.histogram(g) == recounted,
+                                   describe("histogram of " + toString(guesses[g]) + " differs")))
+                {
+                    return;
+                }
+            }
+        }
+    }, 10);
+}
+
+void checkSearchBestGuess(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        // Check the large candidate set after the first move and the small one at the end
+        CombinationList candidates = allCombinations;
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            reference::filterCombinations(candidates, history.moves[move].guess, history.moves[move].score);
+            if (move != 0 && move + 1 != history.moves.size())
+            {
+                continue;
+            }
+
+            for (Strategy strategy : {Strategy::Minimax, Strategy::Entropy, Strategy::Lookahead})
+            {
+                // The reference lookahead scores too many pairs for large sets
+                if (strategy == Strategy::Lookahead && candidates.size() > 200)
+                {
+                    continue;
+                }
+
+                // The time budget would make the lookahead depend on the machine
+                GuessEvaluation expected;
+                GuessEvaluation actual;
+                if (strategy == Strategy::Lookahead)
+                {
+                    LookaheadOptions unbudgeted;
+                    unbudgeted.budget = std::chrono::hours(1);
+                    expected = reference::searchLookahead(level, candidates, unbudgeted.breadth);
+                    actual = searchLookahead(level, candidates, unbudgeted);
+                }
+                else
+                {
+                    expected = reference::searchBestGuess(strategy, level, candidates);
+                    actual = searchBestGuess(strategy, level, candidates);
+                }
+                report.expect(actual.guess == expected.guess, [&]()
+                {
+                    return std::string(strategyName(strategy)) + ", level " + std::to_string(level)
+                           + ", secret " + toString(history.secret) + ", move " + std::to_string(move + 1)
+                           + ": best guess " + toString(actual.guess) + ", expected " + toString(expected.guess);
+                });
+            }
+        }
+    }, 20);
+}
+
+void checkLookahead(CheckReport& report, const VerifyOptions& options)
+{
+    // Looking ahead from every guess must find the best two-step value at the small levels
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        if (level > 6)
+        {
+            return;
+        }
+
+        CombinationList candidates = allCombinations;
+        for (std::size_t move = 0; move <= history.moves.size() && move < 3; move++)
+        {
+            if (candidates.size() > 2 && candidates.size() <= 150)
+            {
+                LookaheadOptions exhaustive;
+                exhaustive.breadth = allCombinations.size();
+                exhaustive.budget = std::chrono::hours(1);
+                GuessEvaluation actual = searchLookahead(level, candidates, exhaustive);
+                GuessEvaluation expected = reference::searchLookahead(level, candidates, allCombinations.size());
+                report.expect(actual.isComplete, [&]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret) + ", move "
+                           + std::to_string(move + 1) + ": a search without time limit is not complete";
+                });
+                double actualValue = reference::lookaheadValue(level, actual.guess, candidates);
+                double expectedValue = reference::lookaheadValue(level, expected.guess, candidates);
+                report.expect(std::abs(actualValue - expectedValue) < 1e-9, [&]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret) + ", move "
+                           + std::to_string(move + 1) + ": " + toString(actual.guess) + " leaves "
+                           + std::to_string(actualValue) + " after two guesses, " + toString(expected.guess)
+                           + " leaves " + std::to_string(expectedValue);
+                });
+            }
+
+            if (move < history.moves.size())
+            {
+                reference::filterCombinations(candidates, history.moves[move].guess, history.moves[move].score);
+            }
+        }
+    }, 10);
+
+    // A search cut short by its time budget must say so, so that it is not cached
+    LookaheadOptions expired;
+    expired.budget = std::chrono::milliseconds(0);
+    GuessEvaluation cutShort = searchLookahead(6, reference::generateAllCombinations(6), expired);
+    report.expect(!cutShort.isComplete, [&]()
+    {
+        return std::string("a search without time left is complete");
+    });
+}
+
+/**
+ * @brief A key under which every candidate set collides.
+ */
+CandidateSetKey collidingKey(CombinationSpan)
+{
+    return CandidateSetKey{0, 0};
+}
+
+void checkTranspositionTable(CheckReport& report, const VerifyOptions& options)
+{
+    const int level = 6;
+    CombinationList allCombinations = reference::generateAllCombinations(level);
+    std::mt19937 gen(options.seed);
+    auto randomSet = [&](std::size_t size)
+    {
+        CombinationList candidates;
+        std::sample(allCombinations.begin(), allCombinations.end(), std::back_inserter(candidates), size, gen);
+        return candidates;
+    };
+    auto resultFor = [](const CombinationList& candidates)
+    {
+        GuessEvaluation result;
+        result.guess = candidates.front();
+        result.entropy = static_cast<double>(candidates.size());
+        return result;
+    };
+    auto hits = [&](TranspositionTable& table, const CombinationList& candidates)
+    {
+        std::optional<GuessEvaluation> found = table.find(Strategy::Entropy, level, candidates);
+        return found.has_value() && found->guess == candidates.front()
+               && found->entropy == static_cast<double>(candidates.size());
+    };
+
+    // A stored set is found again, but not for another strategy or level
+    TranspositionTable table(1024 * 1024, 1);
+    CombinationList first = randomSet(20);
+    table.insert(Strategy::Entropy, level, first, resultFor(first));
+    report.expect(hits(table, first) && !table.find(Strategy::Minimax, level, first)
+                  && !table.find(Strategy::Entropy, level + 1, first), [&]()
+    {
+        return std::string("a stored set is not found, or found for another strategy or level");
+    });
+
+    // Sets with the same key are told apart by their combinations
+    TranspositionTable colliding(1024 * 1024, 1, collidingKey);
+    CombinationList second = randomSet(20);
+    colliding.insert(Strategy::Entropy, level, first, resultFor(first));
+    bool rejected = !colliding.find(Strategy::Entropy, level, second) && colliding.statistics().collisions == 1
+                    && hits(colliding, first);
+    colliding.insert(Strategy::Entropy, level, second, resultFor(second));
+    report.expect(rejected && hits(colliding, second) && !colliding.find(Strategy::Entropy, level, first), [&]()
+    {
+        return std::string("a set with the key of another set is not rejected or does not replace it");
+    });
+
+    // With room for four entries, the fifth evicts the first one not used since the last sweep
+    TranspositionTable measure(1024 * 1024, 1);
+    measure.insert(Strategy::Entropy, level, first, resultFor(first));
+    std::size_t entryBytes = measure.statistics().bytes;
+    TranspositionTable clock(4 * entryBytes, 1);
+    std::vector<CombinationList> sets;
+    for (int i = 0; i < 5; i++)
+    {
+        sets.push_back(randomSet(20));
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        clock.insert(Strategy::Entropy, level, sets[i], resultFor(sets[i]));
+    }
+    bool used = hits(clock, sets[0]);
+    clock.insert(Strategy::Entropy, level, sets[4], resultFor(sets[4]));
+    report.expect(used && clock.statistics().evictions == 1 && hits(clock, sets[0]) && !hits(clock, sets[1])
+                  && hits(clock, sets[2]) && hits(clock, sets[3]) && hits(clock, sets[4]), [&]()
+    {
+        return std::string("the clock did not evict the least recently used entry");
+    });
+
+    // The entries never take more than the budget, and sets larger than a shard are not stored
+    const std::size_t capacity = 6 * 1024;
+    TranspositionTable bounded(capacity, 8);
+    std::uniform_int_distribution<std::size_t> size(1, 150);
+    bool withinBudget = true;
+    for (int i = 0; i < 2000 && withinBudget; i++)
+    {
+        CombinationList candidates = randomSet(size(gen));
+        bounded.insert(Strategy::Entropy, level, candidates, resultFor(candidates));
+        withinBudget = bounded.statistics().bytes <= capacity;
+    }
+    CombinationList oversized = allCombinations;
+    bounded.insert(Strategy::Entropy, level, oversized, resultFor(oversized));
+    report.expect(withinBudget && bounded.statistics().evictions > 0
+                  && !bounded.find(Strategy::Entropy, level, oversized), [&]()
+    {
+        return "the entries take " + std::to_string(bounded.statistics().bytes) + " bytes of "
+               + std::to_string(capacity) + ", or an oversized set was stored";
+    });
+}
+
+void checkSolutionStore(CheckReport& report, const VerifyOptions& options)
+{
+    char directory[] = "/tmp/digitmind-verify-XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        report.fail("cannot create a temporary directory");
+        return;
+    }
+
+    // Solve random candidate sets; one of them is stored twice
+    const int level = 6;
+    const Strategy strategy = Strategy::Entropy;
+    CombinationList allCombinations = reference::generateAllCombinations(level);
+    std::mt19937 gen(options.seed);
+    std::vector<CombinationList> sets;
+    std::vector<StoredSolution> solutions;
+    for (int i = 0; i < 50; i++)
+    {
+        CombinationList candidates;
+        std::sample(allCombinations.begin(), allCombinations.end(), std::back_inserter(candidates), 3 + i, gen);
+        GuessEvaluation evaluation = searchBestGuess(strategy, level, candidates);
+        solutions.push_back(makeStoredSolution(hashCandidateSet(candidates), evaluation));
+        sets.push_back(candidates);
+    }
+    solutions.push_back(solutions.front());
+
+    std::string path = std::string(directory) + "/store.solutions";
+    std::optional<SolutionStore> store;
+    if (writeSolutionStore(path, strategy, level, solutions))
+    {
+        store = SolutionStore::open(path, strategy, level);
+    }
+    if (!report.expect(store.has_value() && store->size() == sets.size(), [&]()
+        {
+            return std::string("the written store is not opened or holds duplicates");
+        }))
+    {
+        std::remove(path.c_str());
+        rmdir(directory);
+        return;
+    }
+
+    // Every solved set is found with its evaluation; another set is not
+    for (const CombinationList& candidates : sets)
+    {
+        GuessEvaluation expected = searchBestGuess(strategy, level, candidates);
+        std::optional<GuessEvaluation> found = store->find(hashCandidateSet(candidates));
+        report.expect(found.has_value() && found->guess == expected.guess
+                      && found->largestBucket == expected.largestBucket
+                      && found->bucketCount == expected.bucketCount && found->isCandidate == expected.isCandidate
+                      && found->entropy == static_cast<float>(expected.entropy)
+                      && found->expectedSize == static_cast<float>(expected.expectedSize), [&]()
+        {
+            return "the solution of " + std::to_string(candidates.size()) + " candidates is not read back";
+        });
+    }
+    report.expect(!store->find(hashCandidateSet(allCombinations)), [&]()
+    {
+        return std::string("an unsolved set is found");
+    });
+
+    // A store of another strategy, level, strategy version or size is rejected
+    report.expect(!SolutionStore::open(path, Strategy::Minimax, level)
+                  && !SolutionStore::open(path, strategy, level + 1), [&]()
+    {
+        return std::string("a store is opened for another strategy or level");
+    });
+    auto patched = [&](std::size_t offset, std::uint32_t value)
+    {
+        std::string copy = std::string(directory) + "/patched.solutions";
+        std::vector<StoredSolution> unchanged = store->solutions();
+        writeSolutionStore(copy, strategy, level, unchanged);
+        {
+            std::fstream file(copy, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        bool opened = SolutionStore::open(copy, strategy, level).has_value();
+        std::remove(copy.c_str());
+        return opened;
+    };
+    std::uint32_t version = static_cast<std::uint32_t>(strategyVersion(strategy));
+    // Rewriting the level with its own value keeps the store valid
+    report.expect(patched(offsetof(SolutionStoreHeader, level), level)
+                  && !patched(offsetof(SolutionStoreHeader, strategyVersion), version + 1)
+                  && !patched(offsetof(SolutionStoreHeader, solutionCount), 1000), [&]()
+    {
+        return std::string("a store of another strategy version or with missing solutions is opened");
+    });
+
+    store.reset();
+    std::remove(path.c_str());
+    rmdir(directory);
+}
+
+/**
+ * @brief Checks a candidate store against the reference filter and scoring.
+ *
+ * A candidate store is constructed from a CombinationList and provides
+ * filter(guess, score), histogram(guess) and combinations(). After every move
+ * of a history the remaining combinations must equal those of the reference
+ * filter, and the histograms of a sample of guesses must equal a recount.
+ */
+template <typename Store>
+void checkCandidateStore(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        Store store(allCombinations);
+        CombinationList expected = allCombinations;
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            const auto& [guess, score] = history.moves[move];
+            auto describe = [&](const std::string& problem)
+            {
+                return [&, problem]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                           + ", move " + std::to_string(move + 1) + ": " + problem;
+                };
+            };
+
+            for (std::size_t g = move % 29; g < allCombinations.size(); g += 29)
+            {
+                OutcomeHistogram recounted{};
+                for (const DigitCombination& code : expected)
+                {
+                    recounted[outcomeIndex(reference::calculateScore(allCombinations[g], code))]++;
+                }
+                if (!report.expect(store.histogram(allCombinations[g]) == recounted,
+                                   describe("histogram of " + toString(allCombinations[g]) + " differs")))
+                {
+                    return;
+                }
+            }
+
+            reference::filterCombinations(expected, guess, score);
+            store.filter(guess, score);
+            if (!report.expect(store.combinations() == expected, describe("filtered candidates differ")))
+            {
+                return;
+            }
+        }
+    });
+
+    // No candidate gives a score that cannot occur, such as one whose counts
+    // only match a real score in their low bits
+    CombinationList allCombinations = reference::generateAllCombinations(6);
+    for (auto [right, wrong] : {std::pair{0, 10}, std::pair{2, 8}, std::pair{8, 0}, std::pair{0, -1},
+                                std::pair{-1, 1}, std::pair{3, 5}})
+    {
+        Score score;
+        score.right_position = right;
+        score.wrong_position = wrong;
+        Store store(allCombinations);
+        store.filter(allCombinations[17], score);
+        report.expect(store.combinations().empty(), [&]()
+        {
+            return "candidates left for score " + std::to_string(right) + " right, " + std::to_string(wrong)
+                   + " wrong";
+        });
+    }
+}
+
+void checkFilterPipeline(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        CombinationList candidates = allCombinations;
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            const auto& [guess, score] = history.moves[move];
+            FilterPipeline pipeline(guess, score);
+            std::size_t accepted = 0;
+            bool matches = true;
+            for (const DigitCombination& code : candidates)
+            {
+                bool expected = reference::calculateScore(guess, code) == score;
+                bool actual = pipeline(code);
+                matches = matches && actual == expected;
+                accepted += actual;
+            }
+
+            const FilterPipeline::Statistics& stats = pipeline.statistics();
+            bool counted = stats.examined == candidates.size()
+                           && stats.rejectedShared + stats.rejectedRight + accepted == stats.examined;
+            if (!report.expect(matches && counted, [&]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret) + ", move "
+                           + std::to_string(move + 1) + ": pipeline " + (matches ? "statistics" : "result")
+                           + " differs";
+                }))
+            {
+                return;
+            }
+            reference::filterCombinations(candidates, guess, score);
+        }
+    });
+
+    // Guesses the pipeline cannot take fall back to scoring every candidate
+    const DigitCombination unsupported[] = {{1, 1, 2, 3}, {0, 0, 0, 0}, {3, 2, 3, 2}};
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        const CombinationList allCombinations = reference::generateAllCombinations(level);
+        for (const DigitCombination& guess : unsupported)
+        {
+            report.expect(!FilterPipeline::supports(guess), [&]()
+            {
+                return "pipeline accepts guess " + toString(guess);
+            });
+            for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+            {
+                CombinationList expected = allCombinations;
+                CombinationList actual = allCombinations;
+                reference::filterCombinations(expected, guess, outcomeScore(outcome));
+                filterCombinations(actual, guess, outcomeScore(outcome));
+                if (!report.expect(actual == expected, [&]()
+                    {
+                        return "level " + std::to_string(level) + ", guess " + toString(guess) + ", outcome "
+                               + std::to_string(outcome) + ": filterCombinations differs";
+                    }))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void checkFilterByHistory(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        // Every prefix of the history, and the history repeated beyond the
+        // longest compiled predicate
+        CombinationList expected = allCombinations;
+        GameHistory moves;
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            moves.push_back(history.moves[move]);
+            reference::filterCombinations(expected, moves.back().guess, moves.back().score);
+            if (!report.expect(filterByHistory(allCombinations, moves) == expected, [&]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                           + ": filterByHistory differs after move " + std::to_string(move + 1);
+                }))
+            {
+                return;
+            }
+        }
+
+        GameHistory repeated;
+        while (repeated.size() < 20 && !moves.empty())
+        {
+            repeated.insert(repeated.end(), moves.begin(), moves.end());
+        }
+        report.expect(filterByHistory(allCombinations, repeated) == expected, [&]()
+        {
+            return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                   + ": filterByHistory differs for " + std::to_string(repeated.size()) + " moves";
+        });
+
+        // Moves that cannot be compiled, between compiled ones: a guess with a
+        // repeated digit, and scores no guess can receive
+        Move repeatedDigit;
+        repeatedDigit.guess = {history.secret[0], history.secret[0], history.secret[1], history.secret[2]};
+        repeatedDigit.score = reference::calculateScore(repeatedDigit.guess, history.secret);
+        GameHistory mixed = moves;
+        mixed.insert(mixed.begin() + mixed.size() / 2, repeatedDigit);
+        CombinationList mixedExpected = expected;
+        reference::filterCombinations(mixedExpected, repeatedDigit.guess, repeatedDigit.score);
+        report.expect(filterByHistory(allCombinations, mixed) == mixedExpected, [&]()
+        {
+            return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                   + ": filterByHistory differs with a repeated-digit guess";
+        });
+
+        for (auto [right, wrong] : {std::pair{3, 1}, std::pair{2, 8}, std::pair{0, -1}, std::pair{-1, 6}})
+        {
+            Move impossible;
+            impossible.guess = allCombinations.front();
+            impossible.score.right_position = right;
+            impossible.score.wrong_position = wrong;
+            GameHistory withImpossible = moves;
+            withImpossible.insert(withImpossible.begin(), impossible);
+            report.expect(filterByHistory(allCombinations, withImpossible).empty(), [&]()
+            {
+                return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                       + ": candidates left for score " + std::to_string(right) + " right, "
+                       + std::to_string(wrong) + " wrong";
+            });
+        }
+    });
+}
+
+void checkGameAnalysis(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        // The histories stop before the winning move; analyze them with it
+        GameHistory moves = history.moves;
+        moves.push_back(Move{history.secret, reference::calculateScore(history.secret, history.secret)});
+        GameAnalysis analysis = analyzeGame(level, moves);
+        if (!report.expect(analysis.size() == moves.size(), [&]()
+            {
+                return "level " + std::to_string(level) + ", secret " + toString(history.secret) + ": "
+                       + std::to_string(analysis.size()) + " moves analyzed of " + std::to_string(moves.size());
+            }))
+        {
+            return;
+        }
+
+        CombinationList candidates = allCombinations;
+        for (std::size_t move = 0; move < moves.size(); move++)
+        {
+            const MoveAnalysis& moveAnalysis = analysis[move];
+            std::size_t before = candidates.size();
+            GuessEvaluation player = evaluateGuess(moves[move].guess, candidates);
+            reference::filterCombinations(candidates, moves[move].guess, moves[move].score);
+            report.expect(moveAnalysis.candidatesBefore == before && moveAnalysis.candidatesAfter == candidates.size()
+                          && moveAnalysis.player.entropy == player.entropy && moveAnalysis.regret >= 0.0
+                          && moveAnalysis.best.entropy >= player.entropy - 1e-9, [&]()
+            {
+                return "level " + std::to_string(level) + ", secret " + toString(history.secret) + ", move "
+                       + std::to_string(move + 1) + ": " + std::to_string(moveAnalysis.candidatesBefore) + " -> "
+                       + std::to_string(moveAnalysis.candidatesAfter) + " candidates, expected "
+                       + std::to_string(before) + " -> " + std::to_string(candidates.size()) + ", regret "
+                       + std::to_string(moveAnalysis.regret);
+            });
+        }
+    }, 20);
+
+    // The analysis stops at a guess that is not a combination of the level
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        const DigitCombination secret{3, 2, 1, 0};
+        const DigitCombination invalid[] = {{1, 1, 2, 3}, {0, 1, 2, level}, {0, 1, 2, 10}, {-1, 0, 1, 2}};
+        for (const DigitCombination& guess : invalid)
+        {
+            GameHistory moves = {Move{{0, 1, 2, 3}, reference::calculateScore({0, 1, 2, 3}, secret)},
+                                 Move{guess, reference::calculateScore(guess, secret)},
+                                 Move{secret, reference::calculateScore(secret, secret)}};
+            GameAnalysis analysis = analyzeGame(level, moves);
+            report.expect(analysis.size() == 1, [&]()
+            {
+                return "level " + std::to_string(level) + ": " + std::to_string(analysis.size())
+                       + " moves analyzed up to invalid guess " + toString(guess);
+            });
+        }
+    }
+}
+
+void checkPuzzles(CheckReport& report, const VerifyOptions& options)
+{
+    char directory[] = "/tmp/digitmind-verify-XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        report.fail("cannot create a temporary directory");
+        return;
+    }
+
+    // Every level is a view into the tables of the highest level, as in the tool
+    std::string path = std::string(directory) + "/level-" + std::to_string(MAX_LEVEL) + ".tables";
+    std::optional<LevelTables> tables;
+    if (publishLevelTables(path, MAX_LEVEL))
+    {
+        tables = LevelTables::open(path, MAX_LEVEL);
+    }
+    if (!report.expect(tables.has_value(), [&]()
+        {
+            return std::string("tables cannot be published and opened");
+        }))
+    {
+        rmdir(directory);
+        return;
+    }
+
+    for (int level = MIN_LEVEL; level <= MAX_LEVEL; level++)
+    {
+        LevelView view(*tables, level);
+        PuzzleOptions puzzleOptions;
+        puzzleOptions.minClues = 1;
+        puzzleOptions.maxClues = 8;
+        puzzleOptions.maxRightPosition = 2;
+        PuzzleGenerator generator(view, puzzleOptions);
+        CombinationList allCombinations = reference::generateAllCombinations(level);
+        parallelFor(options.historiesPerLevel, [&](std::size_t i)
+        {
+            std::mt19937 gen(options.seed + level * 1000 + static_cast<unsigned>(i));
+            std::optional<Puzzle> puzzle = generator.generate(gen);
+            if (!report.expect(puzzle.has_value(), [&]()
+                {
+                    return "level " + std::to_string(level) + ": no puzzle generated for seed offset "
+                           + std::to_string(i);
+                }))
+            {
+                return;
+            }
+
+            // The solution is the only combination left, and every clue is needed
+            CombinationList solutions = allCombinations;
+            bool withinOptions = puzzle->clues.size() >= puzzleOptions.minClues
+                                 && puzzle->clues.size() <= puzzleOptions.maxClues;
+            for (const Move& clue : puzzle->clues)
+            {
+                reference::filterCombinations(solutions, clue.guess, clue.score);
+                withinOptions = withinOptions && clue.score.right_position <= puzzleOptions.maxRightPosition;
+            }
+            bool minimal = true;
+            for (std::size_t skipped = 0; skipped < puzzle->clues.size(); skipped++)
+            {
+                CombinationList remaining = allCombinations;
+                for (std::size_t c = 0; c < puzzle->clues.size(); c++)
+                {
+                    if (c != skipped)
+                    {
+                        reference::filterCombinations(remaining, puzzle->clues[c].guess, puzzle->clues[c].score);
+                    }
+                }
+                minimal = minimal && remaining.size() > 1;
+            }
+            report.expect(solutions == CombinationList{puzzle->solution} && withinOptions && minimal
+                          && generator.countSolutions(puzzle->clues) == 1, [&]()
+            {
+                return "level " + std::to_string(level) + ", solution " + toString(puzzle->solution) + ": "
+                       + std::to_string(solutions.size()) + " solutions, "
+                       + std::to_string(puzzle->clues.size()) + " clues" + (minimal ? "" : ", not minimal");
+            });
+        });
+    }
+    tables.reset();
+    std::remove(path.c_str());
+    rmdir(directory);
+}
+
+void checkAliasTable(CheckReport& report, const VerifyOptions& options)
+{
+    // Skewed weights with zeros; the draws must follow them within six standard deviations
+    std::vector<double> weights = {0.0, 1.0, 2.0, 0.0, 64.0, 0.5, 8.0, 8.0, 3.0, 0.0, 0.25};
+    double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    AliasTable table(weights);
+    std::mt19937 gen(options.seed);
+    const int draws = 1000000;
+    std::vector<int> counts(weights.size(), 0);
+    for (int i = 0; i < draws; i++)
+    {
+        counts[table.sample(gen)]++;
+    }
+    for (std::size_t i = 0; i < weights.size(); i++)
+    {
+        double p = weights[i] / total;
+        double deviation = std::abs(counts[i] - p * draws);
+        report.expect(weights[i] == 0.0 ? counts[i] == 0 : deviation <= 6 * std::sqrt(draws * p * (1 - p)), [&]()
+        {
+            return "index " + std::to_string(i) + " drawn " + std::to_string(counts[i]) + " times, expected "
+                   + std::to_string(p * draws);
+        });
+    }
+}
+
+void checkSecretDifficulty(CheckReport& report, const VerifyOptions& options)
+{
+    char directory[] = "/tmp/digitmind-verify-XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        report.fail("cannot create a temporary directory");
+        return;
+    }
+
+    // The larger levels take longer to search than the others together
+    for (int level = MIN_LEVEL; level <= 7; level++)
+    {
+        Strategy strategy = Strategy::Entropy;
+        DifficultyTable table(strategy, level, measureGuessCounts(strategy, level));
+        CombinationList allCombinations = reference::generateAllCombinations(level);
+
+        // Every secret takes as many guesses as playing the strategy against it
+        parallelFor(allCombinations.size(), [&](std::size_t i)
+        {
+            const DigitCombination& secret = allCombinations[i];
+            CombinationList candidates = allCombinations;
+            GameHistory history;
+            Score score;
+            do
+            {
+                DigitCombination guess = findBestGuess(strategy, level, history, candidates).guess;
+                score = reference::calculateScore(guess, secret);
+                history.push_back(Move{guess, score});
+                reference::filterCombinations(candidates, guess, score);
+            } while (score.right_position < 4);
+
+            report.expect(table.guesses(i) == static_cast<int>(history.size()), [&]()
+            {
+                return "level " + std::to_string(level) + ", secret " + toString(secret) + ": "
+                       + std::to_string(table.guesses(i)) + " guesses, played "
+                       + std::to_string(history.size());
+            });
+        });
+
+        std::string path = std::string(directory) + "/level-" + std::to_string(level) + ".difficulty";
+        std::optional<DifficultyTable> read;
+        if (table.write(path))
+        {
+            read = DifficultyTable::open(path, strategy, level);
+        }
+        bool identical = read.has_value() && read->size() == table.size();
+        for (std::size_t i = 0; identical && i < table.size(); i++)
+        {
+            identical = read->guesses(i) == table.guesses(i);
+        }
+        report.expect(identical && !DifficultyTable::open(path, Strategy::Minimax, level)
+                      && !DifficultyTable::open(path, strategy, level + 1), [&]()
+        {
+            return "level " + std::to_string(level) + ": difficulty table is not read back as written";
+        });
+        std::remove(path.c_str());
+
+        // Every tier draws secrets of its guess counts only
+        SecretSelector selector(table, allCombinations);
+        int average = static_cast<int>(std::lround(table.averageGuesses()));
+        std::mt19937 gen(options.seed + level);
+        for (SecretTier tier : {SecretTier::Easy, SecretTier::Medium, SecretTier::Hard})
+        {
+            for (int draw = 0; draw < 1000; draw++)
+            {
+                const DigitCombination& secret = selector.select(tier, gen);
+                std::size_t i = std::lower_bound(allCombinations.begin(), allCombinations.end(), secret)
+                                - allCombinations.begin();
+                int guesses = table.guesses(i);
+                bool inTier = tier == SecretTier::Easy ? guesses < average
+                              : tier == SecretTier::Medium ? guesses == average : guesses > average;
+                if (!report.expect(inTier, [&]()
+                    {
+                        return "level " + std::to_string(level) + ": tier " + std::to_string(static_cast<int>(tier))
+                               + " drew " + toString(secret) + " with " + std::to_string(guesses) + " guesses";
+                    }))
+                {
+                    break;
+                }
+            }
+        }
+    }
+    rmdir(directory);
+}
+
+void checkOutcomePartition(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        CombinationList candidates = allCombinations;
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            const auto& [guess, score] = history.moves[move];
+            OutcomePartition partition(guess, candidates);
+            for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+            {
+                CombinationList expected = candidates;
+                reference::filterCombinations(expected, guess, outcomeScore(outcome));
+                CombinationSpan bucket = partition.bucket(outcome);
+                bool matches = std::equal(bucket.begin(), bucket.end(), expected.begin(), expected.end())
+                               && partition.histogram()[outcome] == static_cast<int>(expected.size());
+                if (!report.expect(matches, [&]()
+                    {
+                        return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                               + ", move " + std::to_string(move + 1) + ": bucket of "
+                               + toString(outcomeScore(outcome)) + " for " + toString(guess) + " differs";
+                    }))
+                {
+                    return;
+                }
+            }
+            reference::filterCombinations(candidates, guess, score);
+        }
+    }, 4);
+}
+
+void checkCompressedSet(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        std::size_t words = (allCombinations.size() + 63) / 64;
+        CompressedSet set = CompressedSet::all(allCombinations.size());
+        std::vector<std::uint16_t> expected(allCombinations.size());
+        std::iota(expected.begin(), expected.end(), 0);
+
+        for (std::size_t move = 0; move < history.moves.size(); move++)
+        {
+            const auto& [guess, score] = history.moves[move];
+            auto describe = [&](const std::string& problem)
+            {
+                return [&, problem]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                           + ", move " + std::to_string(move + 1) + ": " + problem;
+                };
+            };
+
+            // The partition bitsets of the guess over all ids
+            std::vector<std::vector<std::uint64_t>> partitions(NUM_OUTCOMES, std::vector<std::uint64_t>(words));
+            for (std::size_t id = 0; id < allCombinations.size(); id++)
+            {
+                int outcome = outcomeIndex(reference::calculateScore(guess, allCombinations[id]));
+                partitions[outcome][id / 64] |= std::uint64_t{1} << (id % 64);
+            }
+
+            OutcomeHistogram histogram{};
+            for (std::uint16_t id : expected)
+            {
+                histogram[outcomeIndex(reference::calculateScore(guess, allCombinations[id]))]++;
+            }
+            for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+            {
+                report.expect(set.intersectionCardinality(partitions[outcome].data())
+                                  == static_cast<std::size_t>(histogram[outcome]),
+                              describe("intersection cardinality of " + toString(outcomeScore(outcome)) + " differs"));
+            }
+
+            set = set.intersect(partitions[outcomeIndex(score)].data());
+            std::erase_if(expected, [&](std::uint16_t id)
+            {
+                return !(reference::calculateScore(guess, allCombinations[id]) == score);
+            });
+            bool contained = std::all_of(expected.begin(), expected.end(), [&](std::uint16_t id)
+            {
+                return set.contains(id);
+            });
+            if (!report.expect(set.ids() == expected && set.cardinality() == expected.size() && contained,
+                               describe("intersection differs")))
+            {
+                return;
+            }
+        }
+    }, 2);
+}
+
+/**
+ * @brief Creates a random symmetry of a level.
+ */
+Symmetry randomSymmetry(int level, std::mt19937& gen)
+{
+    Symmetry symmetry;
+    std::shuffle(symmetry.positions.begin(), symmetry.positions.end(), gen);
+    std::shuffle(symmetry.digits.begin(), symmetry.digits.begin() + level, gen);
+    return symmetry;
+}
+
+void checkCanonicalize(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        CombinationList candidates = allCombinations;
+        for (const Move& move : history.moves)
+        {
+            reference::filterCombinations(candidates, move.guess, move.score);
+        }
+        CanonicalState canonical = canonicalize(level, history.moves, candidates);
+
+        auto describe = [&](const std::string& problem)
+        {
+            return [&, problem]()
+            {
+                return "level " + std::to_string(level) + ", secret " + toString(history.secret) + ", "
+                       + std::to_string(history.moves.size()) + " moves: " + problem;
+            };
+        };
+
+        // The canonical state must be the same game as the original
+        CombinationList canonicalCandidates = allCombinations;
+        for (const Move& move : canonical.history)
+        {
+            reference::filterCombinations(canonicalCandidates, move.guess, move.score);
+        }
+        report.expect(canonicalCandidates == canonical.candidates,
+                      describe("canonical candidates do not follow from the canonical history"));
+
+        // Mapping the canonical candidates back must give the original candidates
+        CombinationList mappedBack;
+        for (const DigitCombination& code : canonical.candidates)
+        {
+            mappedBack.push_back(canonical.symmetry.invert(code));
+        }
+        std::sort(mappedBack.begin(), mappedBack.end());
+        report.expect(mappedBack == candidates, describe("inverted canonical candidates differ"));
+
+        // An isomorphic state must have the same canonical form
+        std::mt19937 gen(static_cast<unsigned>(history.moves.size() * 7919 + candidates.size()));
+        Symmetry symmetry = randomSymmetry(level, gen);
+        GameHistory transformed;
+        for (const Move& move : history.moves)
+        {
+            transformed.push_back(Move{symmetry.apply(move.guess), move.score});
+        }
+        if (transformed.size() <= MAX_PERMUTED_MOVES)
+        {
+            std::shuffle(transformed.begin(), transformed.end(), gen);
+        }
+        CombinationList transformedCandidates;
+        for (const DigitCombination& code : candidates)
+        {
+            transformedCandidates.push_back(symmetry.apply(code));
+        }
+        std::sort(transformedCandidates.begin(), transformedCandidates.end());
+
+        CanonicalState other = canonicalize(level, transformed, transformedCandidates);
+        report.expect(other.candidates == canonical.candidates,
+                      describe("isomorphic state has another canonical form"));
+    });
+}
+
+struct Check
+{
+    const char* name;
+    std::function<void(CheckReport&, const VerifyOptions&)> run;
+};
+
+/**
+ * @brief Returns whether two sums of the same weights agree up to rounding.
+ */
+bool nearlyEqual(double a, double b)
+{
+    return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(a) + std::abs(b));
+}
+
+void checkWeightedCandidates(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        const SecretPrior& prior = humanPrior(level);
+
+        // The default switches from weight classes to packed counts during the game
+        std::vector<WeightedCandidates> sets;
+        sets.emplace_back(allCombinations, prior);
+        sets.emplace_back(allCombinations, prior, 0);
+        sets.emplace_back(allCombinations, prior, allCombinations.size() + 1);
+
+        CombinationList expected = allCombinations;
+        for (std::size_t move = 0; move <= history.moves.size(); move++)
+        {
+            auto describe = [&](std::size_t set, const std::string& problem)
+            {
+                return [&, set, problem]()
+                {
+                    return "level " + std::to_string(level) + ", secret " + toString(history.secret) + ", move "
+                           + std::to_string(move + 1) + ", set " + std::to_string(set) + ": " + problem;
+                };
+            };
+
+            double total = 0.0;
+            double highest = 0.0;
+            DigitCombination mostProbable{};
+            for (const DigitCombination& code : expected)
+            {
+                double weight = prior.weight(code);
+                total += weight;
+                if (weight > highest)
+                {
+                    highest = weight;
+                    mostProbable = code;
+                }
+            }
+
+            for (std::size_t set = 0; set < sets.size(); set++)
+            {
+                const WeightedCandidates& weighted = sets[set];
+                if (!report.expect(weighted.size() == expected.size() && nearlyEqual(weighted.totalWeight(), total)
+                                   && weighted.highestWeight() == highest && weighted.mostProbable() == mostProbable,
+                                   describe(set, "size, weights or most probable candidate differ")))
+                {
+                    return;
+                }
+            }
+
+            for (std::size_t g = move % 61; g < allCombinations.size(); g += 61)
+            {
+                WeightedHistogram recounted{};
+                for (const DigitCombination& code : expected)
+                {
+                    int outcome = outcomeIndex(reference::calculateScore(allCombinations[g], code));
+                    recounted.counts[outcome]++;
+                    recounted.weights[outcome] += prior.weight(code);
+                }
+
+                for (std::size_t set = 0; set < sets.size(); set++)
+                {
+                    WeightedHistogram histogram = sets[set].histogram(allCombinations[g]);
+                    bool matches = histogram.counts == recounted.counts;
+                    for (int outcome = 0; outcome < NUM_OUTCOMES; outcome++)
+                    {
+                        matches = matches && nearlyEqual(histogram.weights[outcome], recounted.weights[outcome]);
+                    }
+                    if (!report.expect(matches, describe(set, "histogram of " + toString(allCombinations[g])
+                                                              + " differs")))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            if (move < history.moves.size())
+            {
+                const auto& [guess, score] = history.moves[move];
+                reference::filterCombinations(expected, guess, score);
+                for (WeightedCandidates& weighted : sets)
+                {
+                    weighted.filter(guess, score);
+                }
+            }
+        }
+    }, 4);
+}
+
+void checkBayesian(CheckReport& report, const VerifyOptions& options)
+{
+    forEachHistory(options, [&](int level, const CombinationList& allCombinations, const History& history)
+    {
+        const SecretPrior& prior = humanPrior(level);
+        CombinationList candidates = allCombinations;
+        for (std::size_t move = 0; move <= history.moves.size(); move++)
+        {
+            // Scoring every guess against many candidates is too slow for the reference
+            if (candidates.size() <= 300)
+            {
+                double total = 0.0;
+                double highest = 0.0;
+                DigitCombination mostProbable{};
+                for (const DigitCombination& code : candidates)
+                {
+                    total += prior.weight(code);
+                    if (prior.weight(code) > highest)
+                    {
+                        highest = prior.weight(code);
+                        mostProbable = code;
+                    }
+                }
+
+                // Guessing the most probable candidate, or else the most informative guess
+                GuessEvaluation selected = searchBayesian(level, candidates, prior);
+                bool guessesMostProbable = candidates.size() <= 2 || highest / total > 0.5;
+                double bestEntropy = 0.0;
+                for (std::size_t g = 0; !guessesMostProbable && g < allCombinations.size(); g++)
+                {
+                    std::array<double, NUM_OUTCOMES> weights{};
+                    for (const DigitCombination& code : candidates)
+                    {
+                        weights[outcomeIndex(reference::calculateScore(allCombinations[g], code))] +=
+                            prior.weight(code);
+                    }
+                    double entropy = 0.0;
+                    for (double weight : weights)
+                    {
+                        if (weight > 0.0)
+                        {
+                            entropy -= weight / total * std::log2(weight / total);
+                        }
+                    }
+                    bestEntropy = std::max(bestEntropy, entropy);
+                }
+
+                bool correct = guessesMostProbable ? selected.guess == mostProbable
+                                                   : std::abs(selected.entropy - bestEntropy) < 1e-9;
+                if (!report.expect(correct, [&]()
+                    {
+                        return "level " + std::to_string(level) + ", secret " + toString(history.secret)
+                               + ", move " + std::to_string(move + 1) + ": selected " + toString(selected.guess)
+                               + " with entropy " + std::to_string(selected.entropy) + ", best "
+                               + std::to_string(bestEntropy);
+                    }))
+                {
+                    return;
+                }
+            }
+
+            if (move < history.moves.size())
+            {
+                reference::filterCombinations(candidates, history.moves[move].guess, history.moves[move].score);
+            }
+        }
+    }, 10);
+}
+
+int main(int argc, char* argv[])
+{
+    VerifyOptions options;
+    if (argc > 1)
+    {
+        options.historiesPerLevel = std::atoi(argv[1]);
+    }
+    if (argc > 2)
+    {
+        options.seed = static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10));
+    }
+
+    const std::vector<Check> checks = {
+        {"generateAllCombinations", checkGenerateAllCombinations},
+        {"calculateScore", checkCalculateScore},
+        {"ScoreMatrix", checkScoreMatrix},
+        {"LevelTables", checkLevelTables},
+        {"LevelView", checkLevelViews},
+        {"filterCombinations", checkFilterCombinations},
+        {"FilterPipeline", checkFilterPipeline},
+        {"filterByHistory", checkFilterByHistory},
+        {"canonicalize", checkCanonicalize},
+        {"PartitionHistograms", checkPartitionHistograms},
+        {"searchBestGuess", checkSearchBestGuess},
+        {"analyzeGame", checkGameAnalysis},
+        {"PuzzleGenerator", checkPuzzles},
+        {"AliasTable", checkAliasTable},
+        {"DifficultyTable", checkSecretDifficulty},
+        {"Lookahead", checkLookahead},
+        {"TranspositionTable", checkTranspositionTable},
+        {"SolutionStore", checkSolutionStore},
+        {"WeightedCandidates", checkWeightedCandidates},
+        {"Bayesian", checkBayesian},
+        {"BitSlicedCandidates", checkCandidateStore<BitSlicedCandidates>},
+        {"SoACandidates", checkCandidateStore<SoACandidates>},
+        {"InvertedIndex", checkCandidateStore<InvertedIndex>},
+        {"CandidateSet", checkCandidateStore<CandidateSet>},
+        {"CompressedSet", checkCompressedSet},
+        {"OutcomePartition", checkOutcomePartition},
+    };
+
+    std::cout << "Verifying kernels with " << options.historiesPerLevel << " histories per level, seed "
+              << options.seed << ", " << workerCount() << " threads\n";
+
+    bool allPassed = true;
+    auto total = std::chrono::steady_clock::now();
+    for (const Check& check : checks)
+    {
+        CheckReport report;
+        auto start = std::chrono::steady_clock::now();
+        check.run(report, options);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << (report.failures() == 0 ? "[ OK ] " : "[FAIL] ") << check.name << ": "
+                  << report.cases() << " cases, " << report.failures() << " failures ("
+                  << static_cast<long long>(elapsed.count()) << " ms)\n";
+        for (const std::string& description : report.failureDescriptions())
+        {
+            std::cout << "       " << description << "\n";
+        }
+        allPassed = allPassed && report.failures() == 0;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - total;
+    std::cout << "Total time: " << elapsed.count() << " s\n";
+
+    return allPassed ? 0 : 1;
+}
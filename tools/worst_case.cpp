@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "digitmind.h"
+#include "filter_pipeline.h"
+#include "level_cache.h"
+#include "level_tables.h"
+#include "parallel.h"
+#include "secret_difficulty.h"
+#include "strategy.h"
+
+/**
+ * Finder of the secrets a strategy performs worst on.
+ *
+ * For every secret of a level, the tool measures the expected and the worst
+ * number of guesses of the strategy and prints the secrets ranked by both.
+ * A deterministic strategy is measured once for all secrets by walking its
+ * game tree. The random strategy is played against every secret up to
+ * `seeds` times, in parallel; a secret is dropped early when even the upper
+ * bound of its expected number of guesses falls below the expected number of
+ * the secrets ranked so far, so the games are spent on the hard secrets. The
+ * worst case of a dropped secret is that of the games it was played.
+ * Secret i is played from a generator seeded with i, so the output is
+ * reproducible.
+ *
+ * Usage: DigitMindWorstCase <random|minimax|entropy|lookahead|bayesian> [level] [seeds] [top]
+ *
+ * Without a level, all levels from 4 to 10 are searched. The random strategy
+ * maps the tables of level 10, which serve every level, from the directory
+ * given by the DIGITMIND_CACHE_DIR environment variable and publishes them
+ * there when missing.
+ */
+
+/**
+ * The guesses of a strategy against one secret.
+ */
+struct SecretResult
+{
+    std::size_t secret;     // Index in generation order
+    double expected = 0.0;  // Average number of guesses
+    int worst = 0;          // Most guesses
+    int games = 0;          // Games played
+};
+
+/**
+ * @brief The smallest expected number of guesses among the ranked secrets so
+ * far, shared by the threads.
+ */
+class RankingThreshold
+{
+public:
+    explicit RankingThreshold(std::size_t top) : top(top) {}
+
+    void add(double expected)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ranked.push(expected);
+        if (ranked.size() > top)
+        {
+            ranked.pop();
+        }
+        if (ranked.size() == top)
+        {
+            threshold.store(ranked.top(), std::memory_order_relaxed);
+        }
+    }
+
+    double value() const
+    {
+        return threshold.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::size_t top;
+    std::mutex mutex;
+    std::priority_queue<double, std::vector<double>, std::greater<double>> ranked;
+    std::atomic<double> threshold{-std::numeric_limits<double>::infinity()};
+};
+
+/**
+ * @brief Plays the random strategy against a secret.
+ *
+ * Every guess is drawn uniformly from the possible combinations, as
+ * selectRandomCombination() does in the game. The combinations left after
+ * the first guess are read from the partition bitset of the level tables,
+ * restricted to the level of the view, instead of filtering all combinations.
+ *
+ * @param view The level as a view into the level tables.
+ * @param secret The index of the secret in the view.
+ * @param remaining A list to hold the possible combinations.
+ * @return The number of guesses.
+ */
+int playRandom(const LevelView& view, std::size_t secret, CombinationList& remaining, std::mt19937& gen)
+{
+    const LevelTables& tables = view.tables();
+    std::size_t first = std::uniform_int_distribution<std::size_t>(0, view.size() - 1)(gen);
+    int outcome = view.outcome(first, secret);
+    if (outcome == NUM_OUTCOMES - 1)
+    {
+        return 1;
+    }
+
+    remaining.clear();
+    const std::uint64_t* bits = tables.partition(view.id(first), outcome);
+    for (std::size_t word = 0; word < tables.partitionWords(); word++)
+    {
+        for (std::uint64_t set = bits[word] & view.members()[word]; set != 0; set &= set - 1)
+        {
+            remaining.push_back(tables.combinations()[word * 64 + std::countr_zero(set)]);
+        }
+    }
+
+    for (int guesses = 2;; guesses++)
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, remaining.size() - 1);
+        DigitCombination guess = remaining[pick(gen)];
+        Score score = calculateScore(guess, view.combination(secret));
+        if (score.right_position == 4)
+        {
+            return guesses;
+        }
+        FilterPipeline(guess, score).filter(remaining);
+    }
+}
+
+/**
+ * @brief Plays the random strategy up to `seeds` times against every secret.
+ */
+std::vector<SecretResult> searchRandom(const LevelView& view, int seeds, std::size_t top,
+                                       std::size_t& droppedEarly)
+{
+    std::vector<SecretResult> results(view.size());
+    RankingThreshold threshold(top);
+    std::atomic<std::size_t> dropped{0};
+
+    // Games are played in batches, after which the secret may be dropped
+    const int batch = 32;
+    parallelFor(view.size(), [&](std::size_t i)
+    {
+        SecretResult& result = results[i];
+        result.secret = i;
+        std::mt19937 gen(static_cast<unsigned>(i));
+        CombinationList remaining;
+        double sum = 0.0;
+        double sumOfSquares = 0.0;
+        while (result.games < seeds)
+        {
+            int end = std::min(seeds, result.games + batch);
+            for (; result.games < end; result.games++)
+            {
+                int guesses = playRandom(view, i, remaining, gen);
+                sum += guesses;
+                sumOfSquares += static_cast<double>(guesses) * guesses;
+                result.worst = std::max(result.worst, guesses);
+            }
+
+            // Drop the secret when its mean is three standard errors below the ranking
+            double mean = sum / result.games;
+            double variance = std::max(0.25, sumOfSquares / result.games - mean * mean);
+            if (result.games < seeds && mean + 3 * std::sqrt(variance / result.games) < threshold.value())
+            {
+                dropped++;
+                break;
+            }
+        }
+        result.expected = sum / result.games;
+        if (result.games == seeds)
+        {
+            threshold.add(result.expected);
+        }
+    }, 8);
+
+    droppedEarly = dropped;
+    return results;
+}
+
+/**
+ * @brief Measures a deterministic strategy against every secret.
+ */
+std::vector<SecretResult> searchDeterministic(Strategy strategy, int level)
+{
+    std::vector<std::uint8_t> guesses = measureGuessCounts(strategy, level);
+    std::vector<SecretResult> results(guesses.size());
+    for (std::size_t i = 0; i < guesses.size(); i++)
+    {
+        results[i] = SecretResult{i, static_cast<double>(guesses[i]), guesses[i], 1};
+    }
+    return results;
+}
+
+/**
+ * @brief Prints the top secrets of a ranking.
+ */
+void printRanking(const char* title, std::vector<SecretResult> results, std::size_t top,
+                  const CombinationList& combinations,
+                  const std::function<bool(const SecretResult&, const SecretResult&)>& harder)
+{
+    top = std::min(top, results.size());
+    std::partial_sort(results.begin(), results.begin() + top, results.end(), harder);
+
+    std::cout << title << "\n"
+              << " rank  secret  expected  worst  games\n";
+    for (std::size_t rank = 0; rank < top; rank++)
+    {
+        const SecretResult& result = results[rank];
+        std::string secret;
+        for (int digit : combinations[result.secret])
+        {
+            secret += static_cast<char>('0' + digit);
+        }
+        std::cout << std::setw(5) << rank + 1 << std::setw(8) << secret << std::fixed << std::setprecision(3)
+                  << std::setw(10) << result.expected << std::setw(7) << result.worst << std::setw(7)
+                  << result.games << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
+
+/**
+ * @brief Searches a level and prints both rankings.
+ *
+ * @return Whether the level could be searched.
+ */
+bool searchLevel(Strategy strategy, int level, int seeds, std::size_t top)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::size_t droppedEarly = 0;
+    std::vector<SecretResult> results;
+    if (strategy == Strategy::Random)
+    {
+        std::optional<LevelView> view = attachLevelView(level);
+        if (!view)
+        {
+            std::cerr << "Could not map " << levelTablesPath(10) << "\n";
+            return false;
+        }
+        results = searchRandom(*view, seeds, top, droppedEarly);
+    }
+    else
+    {
+        results = searchDeterministic(strategy, level);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    long long games = 0;
+    for (const SecretResult& result : results)
+    {
+        games += result.games;
+    }
+    std::cout << "\n" << strategyName(strategy) << " level " << level << ": " << results.size() << " secrets, "
+              << games << " games";
+    if (strategy == Strategy::Random)
+    {
+        std::cout << ", " << droppedEarly << " secrets dropped before " << seeds << " games";
+    }
+    std::cout << ", " << elapsed.count() << " s\n";
+
+    // Ties are ranked by the other measure, then in generation order
+    const CombinationList& combinations = levelData(level).combinations;
+    printRanking("Most guesses expected", results, top, combinations, [](const SecretResult& a, const SecretResult& b)
+    {
+        if (a.expected != b.expected)
+        {
+            return a.expected > b.expected;
+        }
+        return a.worst != b.worst ? a.worst > b.worst : a.secret < b.secret;
+    });
+    printRanking("Most guesses in the worst case", results, top, combinations,
+                 [](const SecretResult& a, const SecretResult& b)
+    {
+        if (a.worst != b.worst)
+        {
+            return a.worst > b.worst;
+        }
+        return a.expected != b.expected ? a.expected > b.expected : a.secret < b.secret;
+    });
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    std::optional<Strategy> strategy = argc > 1 ? parseStrategy(argv[1]) : std::nullopt;
+    if (!strategy)
+    {
+        std::cerr << "Usage: DigitMindWorstCase <random|minimax|entropy|lookahead|bayesian> [level] [seeds] [top]\n";
+        return 2;
+    }
+
+    int firstLevel = 4;
+    int lastLevel = 10;
+    if (argc > 2)
+    {
+        firstLevel = lastLevel = std::atoi(argv[2]);
+        if (firstLevel < 4 || firstLevel > 10)
+        {
+            std::cerr << "The level must be between 4 and 10\n";
+            return 2;
+        }
+    }
+    int seeds = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1000;
+    std::size_t top = argc > 4 ? std::max(1, std::atoi(argv[4])) : 10;
+
+    bool success = true;
+    for (int level = firstLevel; level <= lastLevel; level++)
+    {
+        success = searchLevel(*strategy, level, seeds, top) && success;
+    }
+    return success ? 0 : 1;
+}